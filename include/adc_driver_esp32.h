@@ -0,0 +1,80 @@
+#ifndef ADC_DRIVER_ESP32_H
+#define ADC_DRIVER_ESP32_H
+
+#include <Arduino.h>
+#include <driver/adc.h>
+#include "adc_engine.h"
+
+// === Driver ADC1 continuous/DMA (ESP-IDF 4.4, Arduino-ESP32 2.x) ===
+// ESP32: hanya ADC1 yang bisa DMA, sample rate total 20 kHz .. 2 MHz.
+// Selama driver ini jalan, analogRead() pada ADC1 tidak boleh dipakai.
+
+#define ADC_DMA_FRAME_BYTES 256
+#define ADC_DMA_BUFFER_BYTES 1024
+
+class Esp32AdcDmaDriver : public AdcDriver {
+  private:
+    bool running;
+
+  public:
+    Esp32AdcDmaDriver() : running(false) {}
+
+    bool begin(const uint8_t* channels, int count, uint32_t sampleRateHz) override {
+      adc_digi_init_config_t init;
+      memset(&init, 0, sizeof(init));
+      init.max_store_buf_size = ADC_DMA_BUFFER_BYTES;
+      init.conv_num_each_intr = ADC_DMA_FRAME_BYTES;
+      for (int i = 0; i < count; i++) init.adc1_chan_mask |= BIT(channels[i]);
+      if (adc_digi_initialize(&init) != ESP_OK) return false;
+
+      adc_digi_pattern_config_t pattern[ADC_MAX_CHANNELS];
+      memset(pattern, 0, sizeof(pattern));
+      for (int i = 0; i < count; i++) {
+        pattern[i].atten = ADC_ATTEN_DB_11;
+        pattern[i].channel = channels[i];
+        pattern[i].unit = 0; // ADC1
+        pattern[i].bit_width = SOC_ADC_DIGI_MAX_BITWIDTH;
+      }
+
+      adc_digi_configuration_t cfg;
+      memset(&cfg, 0, sizeof(cfg));
+      cfg.conv_limit_en = 1; // wajib di ESP32
+      cfg.conv_limit_num = 250;
+      cfg.pattern_num = count;
+      cfg.adc_pattern = pattern;
+      cfg.sample_freq_hz = sampleRateHz;
+      cfg.conv_mode = ADC_CONV_SINGLE_UNIT_1;
+      cfg.format = ADC_DIGI_OUTPUT_FORMAT_TYPE1;
+      if (adc_digi_controller_configure(&cfg) != ESP_OK) return false;
+      running = adc_digi_start() == ESP_OK;
+      return running;
+    }
+
+    size_t read(AdcSample* out, size_t max, uint32_t timeoutMs) override {
+      uint8_t buf[ADC_DMA_FRAME_BYTES];
+      size_t want = max * SOC_ADC_DIGI_RESULT_BYTES;
+      if (want > sizeof(buf)) want = sizeof(buf);
+      uint32_t got = 0;
+      esp_err_t err = adc_digi_read_bytes(buf, want, &got, timeoutMs);
+      if (err != ESP_OK && err != ESP_ERR_INVALID_STATE) return 0; // INVALID_STATE = overflow, data tetap valid
+
+      size_t n = 0;
+      for (uint32_t i = 0; i + SOC_ADC_DIGI_RESULT_BYTES <= got && n < max; i += SOC_ADC_DIGI_RESULT_BYTES) {
+        adc_digi_output_data_t* p = (adc_digi_output_data_t*)&buf[i];
+        if (p->type1.channel >= SOC_ADC_CHANNEL_NUM(0)) continue;
+        out[n].channel = p->type1.channel;
+        out[n].value = p->type1.data;
+        n++;
+      }
+      return n;
+    }
+
+    void end() override {
+      if (!running) return;
+      adc_digi_stop();
+      adc_digi_deinitialize();
+      running = false;
+    }
+};
+
+#endif
@@ -0,0 +1,141 @@
+#ifndef ADC_ENGINE_H
+#define ADC_ENGINE_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <CicDecimator.h>
+#include "spsc_ring.h"
+
+// === Engine oversampling ADC ===
+// Driver (DMA ESP32 atau mock di host) menghasilkan sampel mentah 12-bit
+// berselang-seling antar channel. Tiap channel didecimate CIC menjadi
+// pembacaan 16-bit di rate aplikasi lalu dikirim lewat ring SPSC lock-free
+// ke consumer (loop()).
+
+#define ADC_MAX_CHANNELS 2
+#define ADC_READ_BATCH 128
+#define ADC_OUTPUT_RING 16
+
+struct AdcSample {
+  uint8_t channel; // nomor channel hardware (mis. ADC1_CHANNEL_6)
+  uint16_t value;  // 12-bit mentah
+};
+
+// Antarmuka driver, diganti mock untuk uji/benchmark di Linux
+class AdcDriver {
+  public:
+    virtual ~AdcDriver() {}
+    virtual bool begin(const uint8_t* channels, int count, uint32_t sampleRateHz) = 0;
+    // Ambil sampel yang sudah ada (maks max), tunggu paling lama timeoutMs
+    virtual size_t read(AdcSample* out, size_t max, uint32_t timeoutMs) = 0;
+    virtual void end() {}
+};
+
+class AdcOversampler {
+  private:
+    AdcDriver& driver;
+    uint8_t channels[ADC_MAX_CHANNELS];
+    int channelCount;
+    uint32_t sampleRateHz;
+    cicDecimator decimators[ADC_MAX_CHANNELS];
+    SpscRing<uint16_t, ADC_OUTPUT_RING> outputs[ADC_MAX_CHANNELS];
+    uint16_t last[ADC_MAX_CHANNELS];
+    bool valid[ADC_MAX_CHANNELS]; // sudah pernah ada output (0 V tetap valid)
+    uint32_t dropped;
+
+  public:
+    AdcOversampler(AdcDriver& d) : driver(d), channelCount(0), sampleRateHz(0), dropped(0) {}
+
+    // sampleRateHz adalah total konversi/detik untuk semua channel
+    bool begin(const uint8_t* hwChannels, int count, uint32_t rateHz,
+               uint8_t cicOrder = 2, uint8_t log2Decimation = 8) {
+      if (count > ADC_MAX_CHANNELS) count = ADC_MAX_CHANNELS;
+      channelCount = count;
+      sampleRateHz = rateHz;
+      for (int i = 0; i < count; i++) {
+        channels[i] = hwChannels[i];
+        decimators[i] = cicDecimator(cicOrder, log2Decimation, 12, 16);
+        last[i] = 0;
+        valid[i] = false;
+      }
+      return driver.begin(channels, count, rateHz);
+    }
+
+    // Decimate satu batch sampel mentah (bagian murni, tanpa driver)
+    void process(const AdcSample* samples, size_t n) {
+      for (size_t i = 0; i < n; i++) {
+        for (int c = 0; c < channelCount; c++) {
+          if (samples[i].channel != channels[c]) continue;
+          uint16_t out;
+          if (decimators[c].push(samples[i].value, out) && !outputs[c].push(out)) dropped++;
+          break;
+        }
+      }
+    }
+
+    // Baca satu batch dari driver lalu process(). Return jumlah sampel mentah.
+    size_t pump(uint32_t timeoutMs) {
+      AdcSample batch[ADC_READ_BATCH];
+      size_t n = driver.read(batch, ADC_READ_BATCH, timeoutMs);
+      process(batch, n);
+      return n;
+    }
+
+    // Consumer: ambil semua output yang tertunda, simpan yang terbaru.
+    // Return false jika belum pernah ada output untuk channel ini.
+    bool latest(int index, uint16_t& out) {
+      uint16_t v;
+      bool fresh = false;
+      while (outputs[index].pop(v)) {
+        last[index] = v;
+        fresh = true;
+      }
+      if (fresh) valid[index] = true;
+      out = last[index];
+      return valid[index];
+    }
+
+    // Rate output per channel (Hz)
+    float outputRateHz() {
+      if (!channelCount) return 0;
+      return (float)sampleRateHz / channelCount / decimators[0].getDecimation();
+    }
+
+    uint32_t getDropped() { return dropped; }
+
+#ifdef ARDUINO
+    // Task prioritas tinggi yang terus memompa DMA -> decimator
+    static void task(void* arg) {
+      AdcOversampler* self = (AdcOversampler*)arg;
+      for (;;) self->pump(100);
+    }
+
+    void startTask(uint32_t stack = 4096, unsigned priority = 5) {
+      xTaskCreatePinnedToCore(task, "adc", stack, this, priority, NULL, 0);
+    }
+#endif
+};
+
+#endif
+
+/*
+*** Example ***
+
+#include "adc_engine.h"
+#include "adc_driver_esp32.h"
+
+Esp32AdcDmaDriver adcDriver;
+AdcOversampler adc(adcDriver);
+const uint8_t adcChannels[] = { ADC1_CHANNEL_6, ADC1_CHANNEL_7 }; // GPIO34, GPIO35
+
+void setup() {
+  adc.begin(adcChannels, 2, 20000, 2, 8); // 10 kHz/channel, /256 -> ~39 Hz, 16-bit
+  adc.startTask();
+}
+
+void loop() {
+  uint16_t mq2;
+  if (adc.latest(0, mq2)) Serial.println(mq2);
+}
+
+*/
@@ -0,0 +1,67 @@
+#ifndef ADC_MOCK_H
+#define ADC_MOCK_H
+
+#include <math.h>
+#include "adc_engine.h"
+
+// === Driver ADC sintetis untuk host ===
+// Tiap channel: offset + amplitude * sin(2*pi*f*t) + noise uniform ±noise LSB,
+// dikuantisasi 12-bit. Tidak ada timing nyata: read() langsung mengisi
+// sebanyak yang diminta, jadi benchmark/uji berjalan secepat CPU.
+
+struct SyntheticChannel {
+  float offset;    // LSB
+  float amplitude; // LSB
+  float frequency; // Hz
+  float noise;     // LSB puncak
+};
+
+class SyntheticAdcDriver : public AdcDriver {
+  private:
+    uint8_t channels[ADC_MAX_CHANNELS];
+    SyntheticChannel signals[ADC_MAX_CHANNELS];
+    int count;
+    uint32_t rateHz;
+    uint64_t index;
+    uint32_t rng;
+
+    float noise() {
+      rng = rng * 1664525u + 1013904223u; // LCG
+      return ((rng >> 8) / 8388608.0f) - 1.0f;
+    }
+
+  public:
+    SyntheticAdcDriver() : count(0), rateHz(1), index(0), rng(12345) {}
+
+    void setSignal(int i, const SyntheticChannel& s) { signals[i] = s; }
+
+    // Nilai ideal (tanpa noise/kuantisasi) channel i pada sampel ke-n
+    float ideal(int i, uint64_t n) {
+      float t = (float)(n / count) * count / rateHz;
+      return signals[i].offset + signals[i].amplitude * sinf(6.2831853f * signals[i].frequency * t);
+    }
+
+    bool begin(const uint8_t* hw, int n, uint32_t sampleRateHz) override {
+      count = n;
+      rateHz = sampleRateHz;
+      for (int i = 0; i < n; i++) {
+        channels[i] = hw[i];
+        SyntheticChannel flat = { 2048, 0, 0, 0 };
+        signals[i] = flat;
+      }
+      return true;
+    }
+
+    size_t read(AdcSample* out, size_t max, uint32_t) override {
+      for (size_t k = 0; k < max; k++, index++) {
+        int c = index % count;
+        float v = ideal(c, index) + signals[c].noise * noise();
+        long q = lroundf(v);
+        out[k].channel = channels[c];
+        out[k].value = q < 0 ? 0 : (q > 4095 ? 4095 : q);
+      }
+      return max;
+    }
+};
+
+#endif
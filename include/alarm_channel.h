@@ -0,0 +1,147 @@
+#ifndef ALARM_CHANNEL_H
+#define ALARM_CHANNEL_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "condition.h"
+#include "frame_encoder.h"
+
+// === Jalur alarm prioritas ===
+// Saat level kondisi naik melewati ambang, frame alarm minimal
+//   "ALM:<level>;SEQ:<n>;SID:<id>\n"          (~36 byte, ~38 ms @ 9600 baud)
+// langsung dikirim, tanpa menunggu frame telemetri rutin. Selama alarm belum
+// di-ACK master ("SID:<id>;ACK:<n>\n"), frame rutin ditunda agar bus bebas
+// untuk ACK, dan alarm dikirim ulang dengan backoff eksponensial. Setelah
+// ALARM_MAX_RETRIES tanpa ACK, channel menyerah dan telemetri rutin berjalan lagi.
+// Pemanggil mengirim satu frame rutin dengan snapshot terbaru begitu alarm
+// tidak lagi menunggu (ACK atau menyerah), bukan semua frame yang tertunda.
+//
+// Tidak bergantung Arduino: waktu disuntikkan, sehingga replay di host
+// memakai logika yang sama.
+
+#ifndef ALARM_THRESHOLD
+#define ALARM_THRESHOLD CONDITION_FIRE
+#endif
+#define ALARM_RETRY_BASE_MS 100
+#define ALARM_RETRY_MAX_MS 2000
+#define ALARM_MAX_RETRIES 8
+#define ALARM_FRAME_MAX 48
+
+class AlarmChannel {
+  private:
+    int threshold;
+    int activeLevel;     // level di frame alarm, tetap sampai ACK/menyerah
+    int episodeLevel;    // level tertinggi episode berjalan (0 = tidak ada episode)
+    bool pending;        // menunggu ACK
+    uint16_t seq;
+    uint32_t nextRetryMs;
+    uint32_t backoffMs;
+    int retries;
+
+    uint32_t sent;
+    uint32_t acked;
+    uint32_t giveUps;
+    uint32_t worstLatencyUs;
+    uint32_t lastLatencyUs;
+
+    void arm(int level, uint32_t nowMs) {
+      activeLevel = level;
+      episodeLevel = level;
+      pending = true;
+      seq++;
+      retries = 0;
+      backoffMs = ALARM_RETRY_BASE_MS;
+      nextRetryMs = nowMs + backoffMs;
+    }
+
+  public:
+    AlarmChannel(int alarmThreshold = ALARM_THRESHOLD)
+      : threshold(alarmThreshold), activeLevel(0), episodeLevel(0), pending(false), seq(0), nextRetryMs(0),
+        backoffMs(ALARM_RETRY_BASE_MS), retries(0), sent(0), acked(0), giveUps(0),
+        worstLatencyUs(0), lastLatencyUs(0) {}
+
+    // Dipanggil tiap hasil klasifikasi. Return true jika frame alarm harus
+    // dikirim SEKARANG (ambang terlewati, atau level naik lagi dalam episode).
+    // Episode yang selesai tidak mengubah alarm yang masih menunggu ACK:
+    // pengiriman ulang tetap membawa level yang sama.
+    bool update(int level, uint32_t nowMs) {
+      if (level < threshold) {
+        episodeLevel = 0; // episode selesai, alarm berikutnya dikirim lagi
+        return false;
+      }
+      if (level <= episodeLevel) return false;
+      arm(level, nowMs);
+      return true;
+    }
+
+    // Dipanggil sesering mungkin. Return true jika waktunya kirim ulang.
+    bool service(uint32_t nowMs) {
+      if (!pending || (int32_t)(nowMs - nextRetryMs) < 0) return false;
+      if (++retries > ALARM_MAX_RETRIES) {
+        pending = false;
+        giveUps++;
+        return false;
+      }
+      backoffMs = backoffMs * 2 > ALARM_RETRY_MAX_MS ? ALARM_RETRY_MAX_MS : backoffMs * 2;
+      nextRetryMs = nowMs + backoffMs;
+      return true;
+    }
+
+    // ACK dari master. Return true jika cocok dengan alarm yang menunggu.
+    bool acknowledge(uint16_t ackSeq) {
+      if (!pending || ackSeq != seq) return false;
+      pending = false;
+      acked++;
+      return true;
+    }
+
+    // Susun frame alarm. Return panjang, 0 jika buffer tidak cukup.
+    size_t encode(const char* sensorId, char* out, size_t cap) {
+      FrameWriter w(out, cap);
+      w.field("ALM", activeLevel);
+      w.field("SEQ", seq);
+      w.puts("SID:"); w.puts(sensorId); w.put('\n');
+      if (w.overflow) return 0;
+      sent++;
+      return w.len;
+    }
+
+    // Latensi sampel selesai -> byte terakhir frame alarm pertama di kabel
+    void recordLatency(uint32_t us) {
+      lastLatencyUs = us;
+      if (us > worstLatencyUs) worstLatencyUs = us;
+    }
+
+    bool isPending() { return pending; }
+    int getLevel() { return activeLevel; }
+    uint16_t getSeq() { return seq; }
+    uint32_t getSent() { return sent; }
+    uint32_t getAcked() { return acked; }
+    uint32_t getGiveUps() { return giveUps; }
+    uint32_t getWorstLatencyUs() { return worstLatencyUs; }
+    uint32_t getLastLatencyUs() { return lastLatencyUs; }
+};
+
+#endif
+
+/*
+*** Example ***
+
+#include "alarm_channel.h"
+
+AlarmChannel alarmChannel;
+char alarmFrame[ALARM_FRAME_MAX];
+
+void loop() {
+  uint32_t t0 = micros();
+  int level = classifyCondition();
+  if (alarmChannel.update(level, millis())) {
+    size_t len = alarmChannel.encode("a1b2c3", alarmFrame, sizeof(alarmFrame));
+    rs485.send((const uint8_t*)alarmFrame, len);
+    alarmChannel.recordLatency(micros() - t0);
+  }
+  if (alarmChannel.service(millis())) { ... kirim ulang ... }
+  if (!alarmChannel.isPending()) sendDataRS485();
+}
+
+*/
@@ -1,10 +1,31 @@
 #ifndef BLUETOOTH_H
 #define BLUETOOTH_H
 #include <BluetoothSerial.h>
+#include "stream_batch.h"
+#include "log.h"
+
 class BluetoothComm {
     private:
       BluetoothSerial btSerial;
       String deviceName;
+      StreamBatcher batcher;
+      TaskHandle_t streamTaskHandle = NULL;
+      volatile bool streaming = false;
+
+      // Task TX: write() SPP boleh blocking di sini, bukan di loop akuisisi
+      static void streamTask(void* arg) {
+        BluetoothComm* self = (BluetoothComm*)arg;
+        for (;;) {
+          size_t len;
+          const uint8_t* batch = self->batcher.acquire(len);
+          if (!batch) {
+            vTaskDelay(pdMS_TO_TICKS(5));
+            continue;
+          }
+          bool delivered = self->btSerial.hasClient() && self->btSerial.write(batch, len) == len;
+          self->batcher.release(batch, delivered);
+        }
+      }
     
     public:
         BluetoothComm(const String& name = "ESP32-BT") : deviceName(name) {}
@@ -42,6 +63,32 @@ class BluetoothComm {
             return incoming;
         }
 
+        // === Streaming biner sampel mentah (commissioning) ===
+        // Sampel dikumpulkan per batch (lihat stream_batch.h) dan dikirim task
+        // terpisah. Jika link SPP macet, batch dibuang utuh dan dihitung.
+        void startStream(int samplesPerBatch = 16) {
+          batcher.begin(samplesPerBatch);
+          if (!streamTaskHandle) {
+            xTaskCreatePinnedToCore(streamTask, "btStream", 3072, this, 1, &streamTaskHandle, 0);
+          }
+          streaming = true;
+          LOG_I("📡 Streaming biner aktif, %d sampel/batch", batcher.getBatchSamples());
+        }
+
+        void stopStream() {
+          streaming = false;
+        }
+
+        // Dipanggil dari akuisisi, tidak pernah blocking
+        bool streamSample(const TraceSample& s) {
+          if (!streaming) return false;
+          return batcher.push(s);
+        }
+
+        bool isStreaming() { return streaming; }
+        uint32_t getStreamSent() { return batcher.getSent(); }
+        uint32_t getStreamDropped() { return batcher.getDropped(); }
+
         BluetoothSerial& getSerial() {
             return btSerial;
         }
@@ -73,4 +120,8 @@ void loop() {
   delay(2000);
 }
 
+// Streaming biner:
+//   bt.startStream(16);
+//   bt.streamSample(sample); // di loop akuisisi, TraceSample dari trace_format.h
+
 */
\ No newline at end of file
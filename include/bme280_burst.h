@@ -0,0 +1,230 @@
+#ifndef BME280_BURST_H
+#define BME280_BURST_H
+
+#include <Arduino.h>
+#include <Wire.h>
+
+// === BME280 forced mode, satu burst I2C per sampel ===
+// Suhu, tekanan dan kelembapan mentah dibaca sekaligus (register 0xF7..0xFE)
+// lalu dikompensasi dari satu pembacaan itu (rumus integer datasheet Bosch).
+// Library Adafruit membaca suhu ulang di setiap readHumidity()/readPressure().
+
+#define BME280_I2C_CLOCK 400000
+#define BME280_CHIP_ID 0x60
+
+#define BME280_REG_CALIB_00 0x88
+#define BME280_REG_CALIB_26 0xE1
+#define BME280_REG_CHIP_ID 0xD0
+#define BME280_REG_RESET 0xE0
+#define BME280_REG_CTRL_HUM 0xF2
+#define BME280_REG_STATUS 0xF3
+#define BME280_REG_CTRL_MEAS 0xF4
+#define BME280_REG_CONFIG 0xF5
+#define BME280_REG_DATA 0xF7
+
+// Nilai oversampling (osrs_x) dan koefisien IIR sesuai datasheet
+enum BME280Oversampling { BME280_OS_SKIP = 0, BME280_OS_X1, BME280_OS_X2, BME280_OS_X4, BME280_OS_X8, BME280_OS_X16 };
+enum BME280Filter { BME280_FILTER_OFF = 0, BME280_FILTER_X2, BME280_FILTER_X4, BME280_FILTER_X8, BME280_FILTER_X16 };
+
+struct BME280Config {
+  uint8_t osrsT;
+  uint8_t osrsP;
+  uint8_t osrsH;
+  uint8_t filter;
+};
+
+// Rekomendasi datasheet untuk weather monitoring: x1/x1/x1, filter off
+#define BME280_DEFAULT_CONFIG { BME280_OS_X1, BME280_OS_X1, BME280_OS_X1, BME280_FILTER_OFF }
+
+struct BME280Reading {
+  float temperature; // °C
+  float pressure;    // hPa
+  float humidity;    // %RH
+};
+
+class BME280Burst {
+  private:
+    TwoWire& wire;
+    uint8_t address;
+    BME280Config config;
+
+    // Kalibrasi dari NVM sensor
+    uint16_t T1; int16_t T2, T3;
+    uint16_t P1; int16_t P2, P3, P4, P5, P6, P7, P8, P9;
+    uint8_t H1, H3; int16_t H2, H4, H5; int8_t H6;
+
+    bool writeReg(uint8_t reg, uint8_t value) {
+      wire.beginTransmission(address);
+      wire.write(reg);
+      wire.write(value);
+      return wire.endTransmission() == 0;
+    }
+
+    bool readRegs(uint8_t reg, uint8_t* out, uint8_t len) {
+      wire.beginTransmission(address);
+      wire.write(reg);
+      if (wire.endTransmission(false) != 0) return false;
+      if (wire.requestFrom(address, len) != len) return false;
+      for (uint8_t i = 0; i < len; i++) out[i] = wire.read();
+      return true;
+    }
+
+    bool readCalibration() {
+      uint8_t c[26];
+      uint8_t h[7];
+      if (!readRegs(BME280_REG_CALIB_00, c, sizeof(c))) return false;
+      if (!readRegs(BME280_REG_CALIB_26, h, sizeof(h))) return false;
+
+      T1 = c[0] | (c[1] << 8);  T2 = c[2] | (c[3] << 8);  T3 = c[4] | (c[5] << 8);
+      P1 = c[6] | (c[7] << 8);  P2 = c[8] | (c[9] << 8);  P3 = c[10] | (c[11] << 8);
+      P4 = c[12] | (c[13] << 8); P5 = c[14] | (c[15] << 8); P6 = c[16] | (c[17] << 8);
+      P7 = c[18] | (c[19] << 8); P8 = c[20] | (c[21] << 8); P9 = c[22] | (c[23] << 8);
+      H1 = c[25];
+      H2 = h[0] | (h[1] << 8);
+      H3 = h[2];
+      H4 = ((int8_t)h[3] << 4) | (h[4] & 0x0F);
+      H5 = ((int8_t)h[5] << 4) | (h[4] >> 4);
+      H6 = (int8_t)h[6];
+      return true;
+    }
+
+    // Konversi oversampling ke jumlah sampel (0 = skip)
+    static uint8_t osSamples(uint8_t osrs) {
+      return osrs == BME280_OS_SKIP ? 0 : (1 << (osrs - 1));
+    }
+
+  public:
+    BME280Burst(TwoWire& w = Wire) : wire(w), address(0x76) {
+      BME280Config def = BME280_DEFAULT_CONFIG;
+      config = def;
+    }
+
+    // Init sensor. Bus I2C harus sudah Wire.begin(); clock diset 400 kHz.
+    bool begin(uint8_t addr = 0x76, const BME280Config& cfg = BME280_DEFAULT_CONFIG) {
+      address = addr;
+      config = cfg;
+      wire.setClock(BME280_I2C_CLOCK);
+
+      uint8_t id;
+      if (!readRegs(BME280_REG_CHIP_ID, &id, 1) || id != BME280_CHIP_ID) return false;
+      writeReg(BME280_REG_RESET, 0xB6);
+      delay(3);
+
+      // Tunggu salinan NVM selesai (status.im_update)
+      uint8_t status = 1;
+      for (int i = 0; i < 10 && readRegs(BME280_REG_STATUS, &status, 1) && (status & 0x01); i++) delay(1);
+      if (!readCalibration()) return false;
+
+      // ctrl_hum baru berlaku setelah ctrl_meas ditulis; mode tetap sleep
+      return writeReg(BME280_REG_CTRL_HUM, config.osrsH & 0x07)
+          && writeReg(BME280_REG_CONFIG, (config.filter & 0x07) << 2)
+          && writeReg(BME280_REG_CTRL_MEAS, ((config.osrsT & 0x07) << 5) | ((config.osrsP & 0x07) << 2));
+    }
+
+    // Waktu ukur maksimum forced mode (datasheet 9.1), dalam ms
+    uint16_t measurementTimeMs() {
+      uint32_t us = 1250 + 2300 * osSamples(config.osrsT);
+      if (config.osrsP) us += 2300 * osSamples(config.osrsP) + 575;
+      if (config.osrsH) us += 2300 * osSamples(config.osrsH) + 575;
+      return (us + 999) / 1000;
+    }
+
+    // Mulai satu pengukuran forced mode (tidak menunggu)
+    bool startMeasurement() {
+      return writeReg(BME280_REG_CTRL_MEAS,
+                      ((config.osrsT & 0x07) << 5) | ((config.osrsP & 0x07) << 2) | 0x01);
+    }
+
+    bool isMeasuring() {
+      uint8_t status;
+      return readRegs(BME280_REG_STATUS, &status, 1) && (status & 0x08);
+    }
+
+    // Ambil hasil: satu burst 8 byte lalu kompensasi ketiganya
+    bool fetch(BME280Reading& out) {
+      uint8_t d[8];
+      if (!readRegs(BME280_REG_DATA, d, sizeof(d))) return false;
+      int32_t adcP = ((uint32_t)d[0] << 12) | ((uint32_t)d[1] << 4) | (d[2] >> 4);
+      int32_t adcT = ((uint32_t)d[3] << 12) | ((uint32_t)d[4] << 4) | (d[5] >> 4);
+      int32_t adcH = ((uint32_t)d[6] << 8) | d[7];
+      if (adcT == 0x80000) return false; // belum ada data
+
+      int32_t tFine;
+      out.temperature = compensateTemperature(adcT, tFine) / 100.0f;
+      out.pressure = config.osrsP && adcP != 0x80000
+        ? compensatePressure(adcP, tFine) / 25600.0f : NAN;     // Q24.8 Pa -> hPa
+      out.humidity = config.osrsH && adcH != 0x8000
+        ? compensateHumidity(adcH, tFine) / 1024.0f : NAN;      // Q22.10 %RH
+      return true;
+    }
+
+    // Trigger + tunggu + fetch (blocking, maksimal measurementTimeMs())
+    bool read(BME280Reading& out) {
+      if (!startMeasurement()) return false;
+      delay(measurementTimeMs());
+      for (int i = 0; i < 5 && isMeasuring(); i++) delay(1);
+      return fetch(out);
+    }
+
+    // === Kompensasi integer (datasheet BME280, bab 4.2.3) ===
+    int32_t compensateTemperature(int32_t adcT, int32_t& tFine) {
+      int32_t var1 = ((((adcT >> 3) - ((int32_t)T1 << 1))) * ((int32_t)T2)) >> 11;
+      int32_t var2 = (((((adcT >> 4) - ((int32_t)T1)) * ((adcT >> 4) - ((int32_t)T1))) >> 12) *
+                      ((int32_t)T3)) >> 14;
+      tFine = var1 + var2;
+      return (tFine * 5 + 128) >> 8; // 0.01 °C
+    }
+
+    uint32_t compensatePressure(int32_t adcP, int32_t tFine) {
+      int64_t var1 = ((int64_t)tFine) - 128000;
+      int64_t var2 = var1 * var1 * (int64_t)P6;
+      var2 = var2 + ((var1 * (int64_t)P5) << 17);
+      var2 = var2 + (((int64_t)P4) << 35);
+      var1 = ((var1 * var1 * (int64_t)P3) >> 8) + ((var1 * (int64_t)P2) << 12);
+      var1 = (((((int64_t)1) << 47) + var1)) * ((int64_t)P1) >> 33;
+      if (var1 == 0) return 0;
+      int64_t p = 1048576 - adcP;
+      p = (((p << 31) - var2) * 3125) / var1;
+      var1 = (((int64_t)P9) * (p >> 13) * (p >> 13)) >> 25;
+      var2 = (((int64_t)P8) * p) >> 19;
+      p = ((p + var1 + var2) >> 8) + (((int64_t)P7) << 4);
+      return (uint32_t)p; // Q24.8 Pa
+    }
+
+    uint32_t compensateHumidity(int32_t adcH, int32_t tFine) {
+      int32_t v = tFine - ((int32_t)76800);
+      v = (((((adcH << 14) - (((int32_t)H4) << 20) - (((int32_t)H5) * v)) + ((int32_t)16384)) >> 15) *
+           (((((((v * ((int32_t)H6)) >> 10) * (((v * ((int32_t)H3)) >> 11) + ((int32_t)32768))) >> 10) +
+              ((int32_t)2097152)) * ((int32_t)H2) + 8192) >> 14));
+      v = (v - (((((v >> 15) * (v >> 15)) >> 7) * ((int32_t)H1)) >> 4));
+      v = (v < 0 ? 0 : v);
+      v = (v > 419430400 ? 419430400 : v);
+      return (uint32_t)(v >> 12); // Q22.10 %RH
+    }
+};
+
+#endif
+
+/*
+*** Example ***
+
+#include "bme280_burst.h"
+
+BME280Burst bme;
+
+void setup() {
+  Serial.begin(115200);
+  Wire.begin(21, 22);
+  BME280Config cfg = { BME280_OS_X2, BME280_OS_X4, BME280_OS_X1, BME280_FILTER_X4 };
+  if (!bme.begin(0x76, cfg)) Serial.println("❌ BME280 tidak ditemukan");
+}
+
+void loop() {
+  BME280Reading r;
+  if (bme.read(r)) {
+    Serial.printf("T %.2f °C | P %.2f hPa | H %.2f %%\n", r.temperature, r.pressure, r.humidity);
+  }
+  delay(1000);
+}
+
+*/
@@ -0,0 +1,64 @@
+#ifndef CONDITION_H
+#define CONDITION_H
+
+#include <math.h>
+#include <FixedPoint.h>
+
+// === Level kondisi ===
+#define CONDITION_NORMAL  0
+#define CONDITION_WASPADA 1
+#define CONDITION_BAHAYA  2
+#define CONDITION_FIRE    3
+
+// === Rata-rata suhu sampel terbaru dari semua DS18B20 ===
+// Channel tidak valid (NAN / FixedPoint::invalid, sensor kosong/gagal) dilewati.
+// T: float, double atau FixedPoint (lihat FixedPoint.h).
+template <typename T>
+inline T averageTemperature(const T* temps, int count, int* validCount = 0)
+{
+  sampleSum<T> sum; // FixedPoint: eksak, tanpa saturasi di tengah jalan
+  int valid = 0;
+  for (int i = 0; i < count; i++) {
+    if (!isValidSample(temps[i])) continue;
+    sum.add(temps[i]);
+    valid++;
+  }
+  if (validCount) *validCount = valid;
+  return valid > 0 ? sum.mean(valid) : T(0);
+}
+
+// Klasifikasi kondisi ruangan dari satu snapshot sensor.
+// Tidak bergantung Arduino, sehingga dipakai juga oleh replay di host.
+// ambientTemp (suhu BME280) ikut dirata-rata sebagai channel suhu tambahan;
+// isi nilai tidak valid jika tidak tersedia. Kelembapan tidak valid (BME280
+// tidak terpasang/belum terbaca) tidak menambah skor, sama di float dan fixed.
+template <typename T>
+inline int classifyReading(const T* temps, int tempCount, T ambientTemp,
+                           T humidity, int mq2, int mq7)
+{
+  int valid;
+  T avgTemp = averageTemperature(temps, tempCount, &valid);
+  if (isValidSample(ambientTemp)) {
+    avgTemp = (avgTemp * valid + ambientTemp) / (valid + 1);
+  }
+  int score = 0;
+  if (avgTemp > T(50)) score++;
+  if (isValidSample(humidity) && humidity < T(30)) score++;
+  if (mq2 > 400) score++;
+  if (mq7 > 20) score += mq7 / 20;
+  for (int i = 0; i < tempCount; i++)
+  {
+    if (isValidSample(temps[i]) && sampleAbs(temps[i] - avgTemp) > T(5))
+    {
+      score++;
+      break;
+    }
+  }
+
+  if (score >= 4) return CONDITION_FIRE;         // Kebakaran
+  else if (score == 3) return CONDITION_BAHAYA;  // Bahaya
+  else if (score == 2) return CONDITION_WASPADA; // Waspada
+  else return CONDITION_NORMAL;                  // Normal
+}
+
+#endif
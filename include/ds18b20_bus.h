@@ -0,0 +1,251 @@
+#ifndef DS18B20_BUS_H
+#define DS18B20_BUS_H
+
+#include <Arduino.h>
+#include <OneWire.h>
+#include <DallasTemperature.h>
+#include "sensor_config.h"
+
+// === Manajer bus DS18B20 ===
+// - ROM code di-cache per slot (maks DS18B20_MAX_SENSORS, kelebihannya diabaikan)
+// - Tiap pembacaan divalidasi CRC scratchpad dan sentinel disconnected;
+//   scratchpad nol semua (lolos CRC) dan nilai power-on 85.00 °C (konversi
+//   belum pernah jalan, mis. probe sempat reset) juga ditolak
+// - Sensor yang gagal di-skip dengan backoff eksponensial; setelah
+//   DS18B20_LOST_AFTER kegagalan beruntun slotnya dilepas
+// - Rescan bertahap di background (satu langkah search per panggilan)
+//   untuk mengisi slot kosong dengan probe pengganti tanpa reboot
+// Pembacaan tidak valid dikembalikan sebagai NAN.
+
+#ifndef DS18B20_MAX_SENSORS
+#define DS18B20_MAX_SENSORS expectedSensorCount
+#endif
+#define DS18B20_FAMILY 0x28
+#define DS18B20_BACKOFF_BASE_MS 1000
+#define DS18B20_BACKOFF_MAX_MS 60000
+#define DS18B20_LOST_AFTER 8
+#define DS18B20_RESCAN_INTERVAL_MS 10000
+#define DS18B20_POWER_ON_RAW 0x0550 // 85.00 °C, isi register suhu setelah reset
+
+enum DS18B20Fault {
+  DS18B20_FAULT_CRC,
+  DS18B20_FAULT_DISCONNECTED,
+  DS18B20_FAULT_INVALID // nol semua atau nilai power-on
+};
+
+struct DS18B20Health {
+  uint32_t okCount;
+  uint32_t crcErrors;
+  uint32_t disconnects;
+  uint32_t invalidReads;
+  uint16_t consecutiveFails;
+  uint32_t skipUntil; // millis() sebelum slot ini dibaca lagi
+  bool present;
+};
+
+class DS18B20Bus {
+  private:
+    OneWire& wire;
+    DallasTemperature& dallas;
+    DeviceAddress roms[DS18B20_MAX_SENSORS];
+    DS18B20Health health[DS18B20_MAX_SENSORS];
+    uint32_t nextRescan;
+    bool searching;
+
+    int findSlot(const uint8_t* rom) {
+      for (int i = 0; i < DS18B20_MAX_SENSORS; i++) {
+        if (health[i].present && memcmp(roms[i], rom, 8) == 0) return i;
+      }
+      return -1;
+    }
+
+    int freeSlot() {
+      for (int i = 0; i < DS18B20_MAX_SENSORS; i++) if (!health[i].present) return i;
+      return -1;
+    }
+
+    void attach(int slot, const uint8_t* rom) {
+      memcpy(roms[slot], rom, 8);
+      memset(&health[slot], 0, sizeof(DS18B20Health));
+      health[slot].present = true;
+    }
+
+    // Baca scratchpad 9 byte, return false (dengan jenis kegagalan) jika bus
+    // diam, CRC salah atau isinya nol semua
+    bool readScratchpad(int slot, uint8_t* data, DS18B20Fault& fault) {
+      if (!wire.reset()) {
+        fault = DS18B20_FAULT_DISCONNECTED; // tidak ada presence pulse
+        return false;
+      }
+      wire.select(roms[slot]);
+      wire.write(0xBE);
+      bool allOnes = true, allZero = true;
+      for (int i = 0; i < 9; i++) {
+        data[i] = wire.read();
+        if (data[i] != 0xFF) allOnes = false;
+        if (data[i] != 0x00) allZero = false;
+      }
+      if (allOnes) {
+        fault = DS18B20_FAULT_DISCONNECTED; // probe tidak menjawab, bus pull-up
+        return false;
+      }
+      if (allZero) {
+        fault = DS18B20_FAULT_INVALID; // CRC8 dari nol = 0, jadi lolos CRC
+        return false;
+      }
+      fault = DS18B20_FAULT_CRC;
+      return OneWire::crc8(data, 8) == data[8];
+    }
+
+    void fail(int slot, uint32_t now, DS18B20Fault fault) {
+      DS18B20Health& h = health[slot];
+      if (fault == DS18B20_FAULT_DISCONNECTED) h.disconnects++;
+      else if (fault == DS18B20_FAULT_INVALID) h.invalidReads++;
+      else h.crcErrors++;
+      if (h.consecutiveFails < 0xFFFF) h.consecutiveFails++;
+
+      uint32_t backoff = DS18B20_BACKOFF_BASE_MS;
+      for (int i = 1; i < h.consecutiveFails && backoff < DS18B20_BACKOFF_MAX_MS; i++) backoff <<= 1;
+      if (backoff > DS18B20_BACKOFF_MAX_MS) backoff = DS18B20_BACKOFF_MAX_MS;
+      h.skipUntil = now + backoff;
+
+      // Probe dianggap dicabut: slot bisa diisi probe baru saat rescan
+      if (h.consecutiveFails >= DS18B20_LOST_AFTER) h.present = false;
+    }
+
+  public:
+    DS18B20Bus(OneWire& w, DallasTemperature& d)
+      : wire(w), dallas(d), nextRescan(0), searching(false) {
+      memset(health, 0, sizeof(health));
+    }
+
+    // Scan penuh sekali saat boot. Return jumlah sensor yang didapat.
+    int begin() {
+      dallas.begin();
+      uint8_t rom[8];
+      wire.reset_search();
+      while (wire.search(rom)) {
+        if (rom[0] != DS18B20_FAMILY || OneWire::crc8(rom, 7) != rom[7]) continue;
+        if (findSlot(rom) >= 0) continue;
+        int slot = freeSlot();
+        if (slot < 0) break; // lebih dari kapasitas: diabaikan
+        attach(slot, rom);
+      }
+      wire.reset_search();
+      nextRescan = millis() + DS18B20_RESCAN_INTERVAL_MS;
+      return getPresentCount();
+    }
+
+    // Mulai konversi semua sensor (skip ROM)
+    void requestConversion() {
+      dallas.requestTemperatures();
+    }
+
+    // Baca semua slot ke out[DS18B20_MAX_SENSORS]; slot kosong/gagal = NAN
+    void readAll(float* out, uint32_t now) {
+      for (int i = 0; i < DS18B20_MAX_SENSORS; i++) {
+        out[i] = NAN;
+        DS18B20Health& h = health[i];
+        if (!h.present) continue;
+        if (h.consecutiveFails && (int32_t)(now - h.skipUntil) < 0) continue;
+
+        uint8_t data[9];
+        DS18B20Fault fault;
+        if (!readScratchpad(i, data, fault)) {
+          fail(i, now, fault);
+          continue;
+        }
+
+        // Bit resolusi yang tidak dipakai bernilai tak tentu, dimask
+        int16_t raw = (int16_t)((data[1] << 8) | data[0]);
+        uint8_t resolution = 9 + ((data[4] >> 5) & 0x03);
+        raw &= ~((1 << (12 - resolution)) - 1);
+        if (raw == DS18B20_POWER_ON_RAW) {
+          fail(i, now, DS18B20_FAULT_INVALID); // 85.00 °C asli ikut ditolak, 84.94/85.06 tidak
+          continue;
+        }
+        float temp = raw / 16.0f;
+        if (temp <= DEVICE_DISCONNECTED_C) {
+          fail(i, now, DS18B20_FAULT_DISCONNECTED);
+          continue;
+        }
+        h.okCount++;
+        h.consecutiveFails = 0;
+        out[i] = temp;
+      }
+    }
+
+    // Panggil sering dari loop(). Saat jadwal rescan tiba, lakukan satu
+    // langkah search ROM per panggilan agar tidak memblok lama.
+    void service(uint32_t now) {
+      if (!searching) {
+        if ((int32_t)(now - nextRescan) < 0 || freeSlot() < 0) return;
+        wire.reset_search();
+        searching = true;
+      }
+
+      uint8_t rom[8];
+      if (!wire.search(rom)) {
+        wire.reset_search();
+        searching = false;
+        nextRescan = now + DS18B20_RESCAN_INTERVAL_MS;
+        return;
+      }
+      if (rom[0] != DS18B20_FAMILY || OneWire::crc8(rom, 7) != rom[7]) return;
+      if (findSlot(rom) >= 0) return;
+
+      // ROM yang sama tapi slotnya sempat dilepas: pakai slot lama
+      for (int i = 0; i < DS18B20_MAX_SENSORS; i++) {
+        if (!health[i].present && memcmp(roms[i], rom, 8) == 0) {
+          attach(i, rom);
+          return;
+        }
+      }
+      int slot = freeSlot();
+      if (slot >= 0) attach(slot, rom);
+    }
+
+    int getPresentCount() {
+      int n = 0;
+      for (int i = 0; i < DS18B20_MAX_SENSORS; i++) if (health[i].present) n++;
+      return n;
+    }
+
+    bool isPresent(int slot) { return health[slot].present; }
+    const uint8_t* getAddress(int slot) { return roms[slot]; }
+    const DS18B20Health& getHealth(int slot) { return health[slot]; }
+
+    // Total kegagalan (CRC + disconnect + tidak valid) per slot
+    uint32_t getErrorCount(int slot) {
+      return health[slot].crcErrors + health[slot].disconnects + health[slot].invalidReads;
+    }
+};
+
+#endif
+
+/*
+*** Example ***
+
+#include "ds18b20_bus.h"
+
+OneWire oneWire(4);
+DallasTemperature dallas(&oneWire);
+DS18B20Bus bus(oneWire, dallas);
+
+void setup() {
+  Serial.begin(115200);
+  Serial.printf("%d DS18B20\n", bus.begin());
+}
+
+void loop() {
+  float temps[DS18B20_MAX_SENSORS];
+  bus.requestConversion();
+  bus.readAll(temps, millis());
+  for (int i = 0; i < DS18B20_MAX_SENSORS; i++) {
+    if (temps[i] == temps[i]) Serial.printf("TEMP%d %.2f\n", i + 1, temps[i]);
+  }
+  bus.service(millis());
+  delay(1000);
+}
+
+*/
@@ -0,0 +1,178 @@
+#ifndef FRAME_BATCH_H
+#define FRAME_BATCH_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <math.h>
+#include "frame_encoder.h"
+
+// === Frame batch: N sampel, satu header, nilai delta ===
+// Format (satu baris, tetap KEY:VAL; agar parser master yang sama bisa dipakai):
+//
+//   SID:<id>;B:<n>;Q0:<seq>;T0:<ms>;S0:<gas>,<co>,<t1>..<tk>,<hum>,<prs>;
+//   D1:<dt>,<dgas>,<dco>,<dt1>..<dtk>,<dhum>,<dprs>;D2:...;[TERRi:<n>;]\n
+//
+// Suhu, kelembapan dan tekanan dalam satuan 0.01 (integer). Sampel ke-i
+// dikirim sebagai selisih terhadap sampel ke-(i-1); dt dalam ms. Nomor urut
+// sampel berurutan: sampel ke-i bernomor Q0 + i.
+// Token "x" = nilai tidak valid (DS18B20 kosong/gagal), "=v" = nilai absolut
+// (dipakai jika sampel sebelumnya tidak valid).
+
+#define FRAME_BATCH_MAX 8
+#define FRAME_BATCH_TEMPS 8
+#define FRAME_BATCH_MAX_LEN 512
+#define FRAME_BATCH_INVALID INT32_MIN
+
+struct BatchSample {
+  uint32_t seq;
+  uint32_t timeMs;
+  int32_t gas;
+  int32_t co;
+  int tempCount;
+  int32_t temps[FRAME_BATCH_TEMPS]; // 0.01 °C, FRAME_BATCH_INVALID = tidak valid
+  int32_t humidity;                 // 0.01 %
+  int32_t pressure;                 // 0.01 hPa
+};
+
+// === Konversi sample_t ke satuan 0.01 ===
+inline int32_t toCents(float v)
+{
+  if (v != v) return FRAME_BATCH_INVALID;
+  return (int32_t)lroundf(v * 100.0f);
+}
+
+template <int Frac>
+inline int32_t toCents(FixedPoint<Frac> v)
+{
+  if (!v.isValid()) return FRAME_BATCH_INVALID;
+  return (int32_t)FixedPoint<Frac>::divRound((int64_t)v.raw * 100, FixedPoint<Frac>::ONE);
+}
+
+// Isi BatchSample dari snapshot yang sama dengan basicFrameData
+template <typename T>
+inline BatchSample makeBatchSample(const basicFrameData<T>& f)
+{
+  BatchSample s;
+  s.seq = f.seq;
+  s.timeMs = f.timeMs;
+  s.gas = f.gas;
+  s.co = f.co;
+  s.tempCount = f.tempCount < FRAME_BATCH_TEMPS ? f.tempCount : FRAME_BATCH_TEMPS;
+  for (int i = 0; i < s.tempCount; i++) s.temps[i] = toCents(f.temps[i]);
+  s.humidity = toCents(f.humidity);
+  s.pressure = toCents(f.pressure);
+  return s;
+}
+
+class FrameBatch {
+  private:
+    BatchSample samples[FRAME_BATCH_MAX];
+    int count;
+    int size;          // N: kirim saat jumlah sampel mencapai N
+    uint32_t windowMs; // atau saat sampel pertama sudah berumur windowMs
+
+    static void putValue(FrameWriter& w, int32_t v) {
+      if (v == FRAME_BATCH_INVALID) w.put('x');
+      else w.putInt(v);
+    }
+
+    static void putDelta(FrameWriter& w, int32_t cur, int32_t prev) {
+      if (cur == FRAME_BATCH_INVALID) w.put('x');
+      else if (prev == FRAME_BATCH_INVALID) { w.put('='); w.putInt(cur); }
+      else w.putInt((long)cur - prev);
+    }
+
+  public:
+    FrameBatch(int n = 1, uint32_t window = 5000) : count(0), size(1), windowMs(window) { setSize(n); }
+
+    // N = 1 berarti batching mati (frame tunggal seperti biasa)
+    void setSize(int n) {
+      if (n < 1) n = 1;
+      if (n > FRAME_BATCH_MAX) n = FRAME_BATCH_MAX;
+      size = n;
+    }
+    void setWindow(uint32_t ms) { windowMs = ms; }
+
+    int getSize() { return size; }
+    uint32_t getWindow() { return windowMs; }
+    int getCount() { return count; }
+    bool enabled() { return size > 1; }
+
+    void add(const BatchSample& s) {
+      if (count < FRAME_BATCH_MAX) samples[count++] = s;
+    }
+
+    // Sudah waktunya kirim?
+    bool due(uint32_t nowMs) {
+      if (count == 0) return false;
+      return count >= size || nowMs - samples[0].timeMs >= windowMs;
+    }
+
+    void clear() { count = 0; }
+
+    // Susun frame batch. tempErrors boleh NULL. Return panjang, 0 jika kosong
+    // atau buffer tidak cukup.
+    size_t encode(const char* sensorId, const uint32_t* tempErrors, char* out, size_t cap) {
+      if (count == 0) return 0;
+      FrameWriter w(out, cap);
+      w.puts("SID:"); w.puts(sensorId); w.put(';');
+      w.field("B", count);
+      w.fieldUnsigned("Q0", samples[0].seq);
+      w.fieldUnsigned("T0", samples[0].timeMs);
+
+      const BatchSample& first = samples[0];
+      w.puts("S0:");
+      w.putInt(first.gas); w.put(',');
+      w.putInt(first.co);
+      for (int t = 0; t < first.tempCount; t++) { w.put(','); putValue(w, first.temps[t]); }
+      w.put(','); putValue(w, first.humidity);
+      w.put(','); putValue(w, first.pressure);
+      w.put(';');
+
+      for (int i = 1; i < count; i++) {
+        const BatchSample& s = samples[i];
+        const BatchSample& p = samples[i - 1];
+        w.put('D'); w.putInt(i); w.put(':');
+        w.putUnsigned(s.timeMs - p.timeMs); w.put(',');
+        w.putInt((long)s.gas - p.gas); w.put(',');
+        w.putInt((long)s.co - p.co);
+        for (int t = 0; t < s.tempCount; t++) {
+          w.put(',');
+          putDelta(w, s.temps[t], t < p.tempCount ? p.temps[t] : FRAME_BATCH_INVALID);
+        }
+        w.put(','); putDelta(w, s.humidity, p.humidity);
+        w.put(','); putDelta(w, s.pressure, p.pressure);
+        w.put(';');
+      }
+
+      // Health DS18B20 sekali per batch, sama seperti frame tunggal
+      for (int t = 0; tempErrors && t < first.tempCount; t++) {
+        if (!tempErrors[t]) continue;
+        w.puts("TERR"); w.putInt(t + 1); w.put(':');
+        w.putUnsigned(tempErrors[t]); w.put(';');
+      }
+
+      if (w.len > 0 && !w.overflow) w.buf[w.len - 1] = '\n'; // ';' terakhir jadi akhir baris
+      return w.overflow ? 0 : w.len;
+    }
+};
+
+#endif
+
+/*
+*** Example ***
+
+#include "frame_batch.h"
+
+FrameBatch batch(4, 5000); // 4 sampel atau 5 detik, mana yang duluan
+char out[FRAME_BATCH_MAX_LEN];
+
+void sendSample(const FrameData& f) {
+  batch.add(makeBatchSample(f)); // f.timeMs = waktu akuisisi
+  if (!batch.due(millis())) return;
+  size_t len = batch.encode(f.sensorId, f.tempErrors, out, sizeof(out));
+  batch.clear();
+  if (len) rs485.send((const uint8_t*)out, len);
+}
+
+*/
@@ -0,0 +1,180 @@
+#ifndef FRAME_ENCODER_H
+#define FRAME_ENCODER_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+#include <FixedPoint.h>
+
+// === Isi satu frame telemetri RS485 ===
+// T: float atau FixedPoint (build FIXED_POINT_BUILD), teks frame sama formatnya.
+template <typename T>
+struct basicFrameData {
+  const char* sensorId;
+  uint32_t seq;       // nomor urut sampel, naik monoton (lihat latency_trace.h)
+  uint32_t timeMs;    // waktu akuisisi, millis() slave
+  int gas;            // MQ2 raw ADC
+  int co;             // MQ7 ppm
+  const T* temps;     // suhu terbaru tiap DS18B20, tidak valid = dilewati
+  int tempCount;
+  const uint32_t* tempErrors; // kegagalan baca per DS18B20 (boleh NULL)
+  T humidity;
+  T pressure;         // hPa
+};
+
+typedef basicFrameData<float> FrameData;
+
+// Ukuran maksimum frame teks (SID + SEQ/TS + gas + 4 suhu + error DS18B20
+// + BME280 + trace TR)
+#define FRAME_MAX_LEN 288
+
+// === Penulis teks ke buffer tetap, tanpa heap dan tanpa printf ===
+// Jika buffer penuh, overflow di-set dan sisa tulisan diabaikan.
+struct FrameWriter {
+  char* buf;
+  size_t cap;
+  size_t len;
+  bool overflow;
+
+  FrameWriter(char* out, size_t capacity) : buf(out), cap(capacity), len(0), overflow(false) {}
+
+  void put(char c) {
+    if (len < cap) buf[len++] = c;
+    else overflow = true;
+  }
+
+  void puts(const char* s) {
+    while (*s) put(*s++);
+  }
+
+  void putUnsigned(uint64_t v) {
+    char tmp[20];
+    int n = 0;
+    do { tmp[n++] = '0' + v % 10; v /= 10; } while (v);
+    while (n) put(tmp[--n]);
+  }
+
+  void putInt(long v) {
+    if (v < 0) { put('-'); putUnsigned(0 - (uint64_t)v); }
+    else putUnsigned(v);
+  }
+
+  // Float dengan 2 desimal, hasil sama persis dengan printf("%.2f").
+  // Dihitung eksak dari bit float (mantissa * 2^exp) dengan integer saja,
+  // pembulatan half-to-even seperti printf. Valid untuk |v| < 1e16.
+  void putFixed2(float v) {
+    uint32_t bits;
+    memcpy(&bits, &v, sizeof(bits));
+    bool neg = bits >> 31;
+    int exp = (bits >> 23) & 0xFF;
+    uint32_t mant = bits & 0x7FFFFF;
+
+    if (neg) put('-');
+    if (exp == 0xFF) {
+      puts(mant ? "nan" : "inf");
+      return;
+    }
+
+    // |v| = m * 2^e, yang dicetak = round(m * 100 * 2^e) / 100
+    uint64_t m = exp ? (mant | 0x800000) : mant;
+    int e = exp ? exp - 150 : -149;
+    uint64_t scaled = m * 100; // < 2^31
+    uint64_t whole;
+    uint32_t frac = 0;   // pecahan dalam satuan 2^-32
+    bool sticky = false; // ada bit < 2^-32 yang terbuang
+
+    if (e >= 0) {
+      whole = e > 32 ? UINT64_MAX / 2 : scaled << e;
+    } else if (e >= -32) {
+      whole = scaled >> -e;
+      frac = (uint32_t)(scaled << (32 + e));
+    } else if (e > -64) {
+      whole = 0;
+      int drop = -e - 32;
+      frac = (uint32_t)(scaled >> drop);
+      sticky = (scaled & ((1ULL << drop) - 1)) != 0;
+    } else {
+      whole = 0;
+      sticky = scaled != 0;
+    }
+
+    const uint32_t half = 0x80000000u;
+    if (frac > half || (frac == half && (sticky || (whole & 1)))) whole++;
+
+    putUnsigned(whole / 100);
+    put('.');
+    put('0' + (whole / 10) % 10);
+    put('0' + whole % 10);
+  }
+
+  // Fixed-point dengan 2 desimal: round(raw * 100 / 2^Frac) half-to-even,
+  // aturan yang sama dengan putFixed2(float) sehingga nilai yang bisa
+  // direpresentasikan di kedua tipe tercetak identik.
+  template <int Frac>
+  void putFixed2(FixedPoint<Frac> v) {
+    if (!v.isValid()) {
+      puts("nan");
+      return;
+    }
+    int64_t raw = v.raw;
+    if (raw < 0) { put('-'); raw = -raw; }
+    uint64_t scaled = (uint64_t)raw * 100;
+    uint64_t whole = scaled >> Frac;
+    uint64_t rem = scaled & ((1ULL << Frac) - 1);
+    const uint64_t half = 1ULL << (Frac - 1);
+    if (rem > half || (rem == half && (whole & 1))) whole++;
+
+    putUnsigned(whole / 100);
+    put('.');
+    put('0' + (whole / 10) % 10);
+    put('0' + whole % 10);
+  }
+
+  // Field "KEY:VAL;" (separator terakhir bisa '\n')
+  void field(const char* key, long value, char sep = ';') {
+    puts(key); put(':'); putInt(value); put(sep);
+  }
+
+  // Sama dengan field() untuk nilai tanpa tanda (seq, millis()), tidak
+  // menjadi negatif saat melewati 2^31 seperti cast ke long 32-bit
+  void fieldUnsigned(const char* key, uint64_t value, char sep = ';') {
+    puts(key); put(':'); putUnsigned(value); put(sep);
+  }
+
+  template <typename V>
+  void field2(const char* key, V value, char sep = ';') {
+    puts(key); put(':'); putFixed2(value); put(sep);
+  }
+};
+
+// Susun frame "KEY:VAL;...\n" ke buffer. Return panjang frame,
+// atau 0 jika buffer tidak cukup.
+template <typename T>
+inline size_t encodeFrame(const basicFrameData<T>& f, char* out, size_t cap)
+{
+  FrameWriter w(out, cap);
+  w.puts("SID:"); w.puts(f.sensorId); w.put(';');
+  w.fieldUnsigned("SEQ", f.seq);
+  w.fieldUnsigned("TS", f.timeMs);
+  w.field("GAS", f.gas);
+  w.field("CO", f.co);
+
+  for (int i = 0; i < f.tempCount; i++) {
+    if (!isValidSample(f.temps[i])) continue;
+    w.puts("TEMP"); w.putInt(i + 1); w.put(':');
+    w.putFixed2(f.temps[i]); w.put(';');
+  }
+
+  // Health DS18B20: hanya sensor yang pernah gagal
+  for (int i = 0; f.tempErrors && i < f.tempCount; i++) {
+    if (!f.tempErrors[i]) continue;
+    w.puts("TERR"); w.putInt(i + 1); w.put(':');
+    w.putUnsigned(f.tempErrors[i]); w.put(';');
+  }
+
+  w.field2("HUM", f.humidity);
+  w.field2("PRS", f.pressure, '\n');
+  return w.overflow ? 0 : w.len;
+}
+
+#endif
@@ -0,0 +1,40 @@
+#ifndef HEAP_STATS_H
+#define HEAP_STATS_H
+
+#include <stddef.h>
+
+// === Statistik heap (fragmentasi & high-water mark) ===
+struct HeapStats {
+  size_t freeBytes;     // heap bebas saat ini
+  size_t minFreeBytes;  // heap bebas terendah sejak boot (high-water mark pemakaian)
+  size_t largestBlock;  // blok bebas terbesar, turun jika heap terfragmentasi
+};
+
+#ifdef ARDUINO
+#include <esp_heap_caps.h>
+
+inline HeapStats readHeapStats()
+{
+  HeapStats s;
+  s.freeBytes = heap_caps_get_free_size(MALLOC_CAP_8BIT);
+  s.minFreeBytes = heap_caps_get_minimum_free_size(MALLOC_CAP_8BIT);
+  s.largestBlock = heap_caps_get_largest_free_block(MALLOC_CAP_8BIT);
+  return s;
+}
+
+#else
+#include <malloc.h>
+
+// glibc tidak punya "largest free block"; dipakai total blok bebas di arena
+inline HeapStats readHeapStats()
+{
+  struct mallinfo2 mi = mallinfo2();
+  HeapStats s;
+  s.freeBytes = mi.fordblks;
+  s.minFreeBytes = mi.fordblks;
+  s.largestBlock = mi.fordblks;
+  return s;
+}
+#endif
+
+#endif
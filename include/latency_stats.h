@@ -0,0 +1,337 @@
+#ifndef LATENCY_STATS_H
+#define LATENCY_STATS_H
+
+// === Statistik latensi & loss sisi master (host/Linux, bukan firmware) ===
+// Membaca baris dari bus RS485 (frame telemetri, frame batch, balasan SYNC)
+// dan menghitung per node:
+//   - offset jam slave -> master dari pertukaran SYNC (RTT terkecil menang)
+//   - loss rate dari gap SEQ/Q0, duplikat dan reboot slave
+//   - distribusi latensi per tahap (dari TR) dan end-to-end (TS -> diterima)
+// Format frame lihat latency_trace.h dan frame_batch.h.
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string>
+#include <vector>
+#include <map>
+#include <algorithm>
+#include "parser.h"
+#include "latency_trace.h"
+#include "frame_batch.h"
+
+#define SYNC_WINDOW 8        // pilih RTT terkecil dari 8 pertukaran terakhir
+#define SEQ_REBOOT_GAP 1000  // SEQ mundur lebih dari ini = slave reboot
+
+// === Estimasi offset jam dari pertukaran SYNC ===
+// offset = jam slave - jam master. Drift kristal dikoreksi dengan SYNC berkala.
+// Agar kedua arah simetris, t0 adalah saat byte terakhir permintaan keluar
+// dan t3 saat byte pertama balasan tiba (LatencyCollector mengurangi airtime).
+class ClockSync {
+  private:
+    int64_t offsets[SYNC_WINDOW];
+    uint32_t rtts[SYNC_WINDOW];
+    int count;
+    int head;
+
+  public:
+    ClockSync() : count(0), head(0) {}
+
+    // t0/t3 jam master, t1/t2 millis() slave
+    void offer(int64_t t0, uint32_t t1, uint32_t t2, int64_t t3) {
+      int64_t rtt = (t3 - t0) - (int64_t)(uint32_t)(t2 - t1);
+      if (rtt < 0) rtt = 0;
+      offsets[head] = ((int64_t)t1 - t0 + (int64_t)t2 - t3) / 2;
+      rtts[head] = (uint32_t)rtt;
+      head = (head + 1) % SYNC_WINDOW;
+      if (count < SYNC_WINDOW) count++;
+    }
+
+    bool valid() const { return count > 0; }
+
+    int best() const {
+      int b = 0;
+      for (int i = 1; i < count; i++) if (rtts[i] < rtts[b]) b = i;
+      return b;
+    }
+
+    int64_t offsetMs() const { return valid() ? offsets[best()] : 0; }
+    uint32_t rttMs() const { return valid() ? rtts[best()] : 0; }
+
+    // Waktu slave (millis) ke jam master
+    int64_t toMaster(uint32_t slaveMs) const { return (int64_t)slaveMs - offsetMs(); }
+};
+
+// === Distribusi latensi (cukup untuk ribuan sampel per node) ===
+class LatencyDist {
+  private:
+    std::vector<uint32_t> values;
+    uint64_t sum;
+
+  public:
+    LatencyDist() : sum(0) {}
+
+    void add(uint32_t v) { values.push_back(v); sum += v; }
+    size_t count() const { return values.size(); }
+    double mean() const { return values.empty() ? 0 : (double)sum / values.size(); }
+
+    // p dalam 0..100, nearest-rank
+    uint32_t percentile(double p) const {
+      if (values.empty()) return 0;
+      std::vector<uint32_t> sorted(values);
+      size_t rank = (size_t)(p / 100.0 * (sorted.size() - 1) + 0.5);
+      std::nth_element(sorted.begin(), sorted.begin() + rank, sorted.end());
+      return sorted[rank];
+    }
+
+    uint32_t max() const {
+      return values.empty() ? 0 : *std::max_element(values.begin(), values.end());
+    }
+};
+
+// === Pelacak nomor urut: loss, duplikat, reboot ===
+class SeqTracker {
+  private:
+    bool started;
+    uint32_t last;
+
+  public:
+    unsigned long received;
+    unsigned long lost;
+    unsigned long duplicates;
+    unsigned long reboots;
+
+    SeqTracker() : started(false), last(0), received(0), lost(0), duplicates(0), reboots(0) {}
+
+    // count sampel berurutan mulai dari seq (frame batch), 1 untuk frame tunggal
+    void accept(uint32_t seq, int count = 1) {
+      uint32_t end = seq + count - 1;
+      if (!started) {
+        started = true;
+      } else if (seq > last) {
+        lost += seq - last - 1;
+      } else if (last - seq > SEQ_REBOOT_GAP) {
+        reboots++;
+      } else {
+        duplicates++;
+        return;
+      }
+      last = end;
+      received += count;
+    }
+
+    double lossRate() const {
+      unsigned long total = received + lost;
+      return total ? (double)lost / total : 0;
+    }
+};
+
+// Tahap latensi yang dilaporkan: selisih TR berurutan + kabel (transmit -> diterima)
+enum LatencyStage {
+  LAT_FILTER = 0,  // akuisisi -> filter
+  LAT_CLASSIFY,    // filter -> klasifikasi
+  LAT_QUEUE,       // klasifikasi -> encode (menunggu giliran kirim / batch)
+  LAT_ENCODE,      // encode -> transmit
+  LAT_WIRE,        // transmit -> diterima master (perlu SYNC)
+  LAT_COUNT
+};
+
+static const char* const latencyStageNames[LAT_COUNT] = {
+  "filter", "classify", "queue", "encode", "wire"
+};
+
+struct NodeStats {
+  ClockSync sync;
+  SeqTracker seq;
+  LatencyDist stageUs[LAT_COUNT];
+  LatencyDist endToEndMs; // TS (akuisisi) -> diterima master
+  unsigned long frames;
+  unsigned long unsynced; // sampel sebelum SYNC pertama (tanpa end-to-end)
+
+  NodeStats() : frames(0), unsynced(0) {}
+};
+
+// === Isi satu baris hasil parse ===
+struct TelemetryLine {
+  TokenSpan sid;
+  bool hasSeq, hasTs, hasBatch, hasSync, hasT1, hasT2, hasTrace;
+  long batch;
+  uint64_t seq, ts, q0, t0, syncT0, t1, t2; // ditulis fieldUnsigned()
+  uint32_t trace[STAGE_COUNT - 1]; // us sejak akuisisi: filter, classify, encode, transmit
+  long dt[FRAME_BATCH_MAX];        // D<i>: dt ke sampel sebelumnya
+
+  TelemetryLine() : hasSeq(false), hasTs(false), hasBatch(false), hasSync(false),
+                    hasT1(false), hasT2(false), hasTrace(false),
+                    batch(0), seq(0), ts(0), q0(0), t0(0), syncT0(0), t1(0), t2(0) {
+    sid.ptr = NULL;
+    sid.len = 0;
+    for (int i = 0; i < FRAME_BATCH_MAX; i++) dt[i] = 0;
+  }
+};
+
+namespace latency_detail {
+  inline TelemetryLine& line(void* ctx) { return *(TelemetryLine*)ctx; }
+
+  inline void onB(int, const TokenSpan& v, void* ctx) { line(ctx).hasBatch = spanToLong(v, line(ctx).batch); }
+  inline void onD(int index, const TokenSpan& v, void* ctx) {
+    TokenSpan first[1];
+    if (index < 1 || index >= FRAME_BATCH_MAX) return;
+    if (tokenize(v.ptr, v.len, ",", first, 1) == 1) spanToLong(first[0], line(ctx).dt[index]);
+  }
+  inline void onQ(int index, const TokenSpan& v, void* ctx) { if (index == 0) spanToUnsigned(v, line(ctx).q0); }
+  inline void onSEQ(int, const TokenSpan& v, void* ctx) { line(ctx).hasSeq = spanToUnsigned(v, line(ctx).seq); }
+  inline void onSID(int, const TokenSpan& v, void* ctx) { line(ctx).sid = v; }
+  inline void onSYNC(int, const TokenSpan& v, void* ctx) { line(ctx).hasSync = spanToUnsigned(v, line(ctx).syncT0); }
+  inline void onT(int index, const TokenSpan& v, void* ctx) {
+    TelemetryLine& l = line(ctx);
+    if (index == 0) spanToUnsigned(v, l.t0);
+    else if (index == 1) l.hasT1 = spanToUnsigned(v, l.t1);
+    else if (index == 2) l.hasT2 = spanToUnsigned(v, l.t2);
+  }
+  inline void onTR(int, const TokenSpan& v, void* ctx) {
+    TelemetryLine& l = line(ctx);
+    TokenSpan parts[STAGE_COUNT - 1];
+    if (tokenize(v.ptr, v.len, ",", parts, STAGE_COUNT - 1) != STAGE_COUNT - 1) return;
+    for (int i = 0; i < STAGE_COUNT - 1; i++) {
+      long us;
+      if (!spanToLong(parts[i], us)) return;
+      l.trace[i] = (uint32_t)us;
+    }
+    l.hasTrace = true;
+  }
+  inline void onTS(int, const TokenSpan& v, void* ctx) { line(ctx).hasTs = spanToUnsigned(v, line(ctx).ts); }
+
+  // Terurut! (binary search)
+  static const CommandEntry table[] = {
+    { "B",    onB },
+    { "D",    onD },
+    { "Q",    onQ },
+    { "SEQ",  onSEQ },
+    { "SID",  onSID },
+    { "SYNC", onSYNC },
+    { "T",    onT },
+    { "TR",   onTR },
+    { "TS",   onTS },
+  };
+}
+
+class LatencyCollector {
+  private:
+    std::map<std::string, NodeStats> nodes;
+    unsigned long ignored;
+    uint32_t baud;
+
+    void addSample(NodeStats& n, uint32_t acquireMs, int64_t rxMs) {
+      if (!n.sync.valid()) {
+        n.unsynced++;
+        return;
+      }
+      int64_t e2e = rxMs - n.sync.toMaster(acquireMs);
+      n.endToEndMs.add(e2e < 0 ? 0 : (uint32_t)e2e);
+    }
+
+  public:
+    LatencyCollector(uint32_t busBaud = 9600) : ignored(0), baud(busBaud) {}
+
+    // Lama satu baris di kabel (8N1), ms
+    int64_t airtimeMs(size_t len) const { return ((int64_t)len * 10 * 1000 + baud / 2) / baud; }
+
+    // Satu baris dari bus beserta jam master saat baris selesai diterima
+    void onLine(const char* text, size_t len, int64_t rxMs) {
+      using namespace latency_detail;
+      TelemetryLine l;
+      dispatchKeyValues(text, len, table, sizeof(table) / sizeof(table[0]), &l);
+      if (!l.sid.ptr || l.sid.len == 0) {
+        ignored++;
+        return;
+      }
+      NodeStats& n = nodes[std::string(l.sid.ptr, l.sid.len)];
+
+      if (l.hasSync && l.hasT1 && l.hasT2) {
+        n.sync.offer((int64_t)l.syncT0, (uint32_t)l.t1, (uint32_t)l.t2, rxMs - airtimeMs(len));
+        return;
+      }
+
+      if (l.hasBatch && l.batch > 0) {
+        int count = l.batch < FRAME_BATCH_MAX ? (int)l.batch : FRAME_BATCH_MAX;
+        n.seq.accept((uint32_t)l.q0, count);
+        uint32_t t = (uint32_t)l.t0;
+        for (int i = 0; i < count; i++) {
+          if (i > 0) t += (uint32_t)l.dt[i];
+          addSample(n, t, rxMs);
+        }
+        l.ts = t; // TR milik sampel terakhir
+      } else if (l.hasSeq && l.hasTs) {
+        n.seq.accept((uint32_t)l.seq);
+        addSample(n, (uint32_t)l.ts, rxMs);
+      } else {
+        ignored++; // frame alarm atau frame lama tanpa SEQ
+        return;
+      }
+      n.frames++;
+
+      if (l.hasTrace) {
+        uint32_t prev = 0;
+        for (int i = 0; i < STAGE_COUNT - 1; i++) {
+          n.stageUs[i].add(l.trace[i] - prev);
+          prev = l.trace[i];
+        }
+        if (n.sync.valid()) {
+          // Transmit di jam master: TS + offset TR, lalu sisa sampai diterima
+          int64_t txMasterUs = n.sync.toMaster((uint32_t)l.ts) * 1000 + l.trace[STAGE_TRANSMIT - 1];
+          int64_t wire = rxMs * 1000 - txMasterUs;
+          n.stageUs[LAT_WIRE].add(wire < 0 ? 0 : (uint32_t)wire);
+        }
+      }
+    }
+
+    const std::map<std::string, NodeStats>& getNodes() const { return nodes; }
+    unsigned long getIgnored() const { return ignored; }
+
+    void report(FILE* out) const {
+      for (std::map<std::string, NodeStats>::const_iterator it = nodes.begin(); it != nodes.end(); ++it) {
+        const NodeStats& n = it->second;
+        fprintf(out, "node %s: %lu frame, %lu sampel, loss %.2f %% (%lu hilang, %lu duplikat, %lu reboot)\n",
+                it->first.c_str(), n.frames, n.seq.received, 100.0 * n.seq.lossRate(),
+                n.seq.lost, n.seq.duplicates, n.seq.reboots);
+        if (n.sync.valid()) {
+          fprintf(out, "  sync offset %lld ms, RTT %u ms\n", (long long)n.sync.offsetMs(), (unsigned)n.sync.rttMs());
+        } else {
+          fprintf(out, "  belum ada SYNC, end-to-end tidak dihitung\n");
+        }
+        fprintf(out, "  %-9s %8s %8s %8s %8s %8s\n", "tahap", "n", "p50", "p95", "p99", "max");
+        for (int s = 0; s < LAT_COUNT; s++) {
+          const LatencyDist& d = n.stageUs[s];
+          if (!d.count()) continue;
+          fprintf(out, "  %-9s %8lu %8u %8u %8u %8u us\n", latencyStageNames[s], (unsigned long)d.count(),
+                  (unsigned)d.percentile(50), (unsigned)d.percentile(95), (unsigned)d.percentile(99), (unsigned)d.max());
+        }
+        const LatencyDist& e = n.endToEndMs;
+        if (e.count()) {
+          fprintf(out, "  %-9s %8lu %8u %8u %8u %8u ms\n", "e2e", (unsigned long)e.count(),
+                  (unsigned)e.percentile(50), (unsigned)e.percentile(95), (unsigned)e.percentile(99), (unsigned)e.max());
+        }
+      }
+    }
+};
+
+#endif
+
+/*
+*** Example ***
+
+#include "latency_stats.h"
+
+LatencyCollector stats;
+
+// Master: kirim "SID:<id>;SYNC:<t0>\n" berkala ke tiap slave (t0 = jam
+// master setelah flush), lalu
+// setiap baris yang diterima:
+void onRs485Line(const char* line, size_t len) {
+  stats.onLine(line, len, nowMs());
+}
+
+void printReport() {
+  stats.report(stdout);
+}
+
+*/
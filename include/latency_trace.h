@@ -0,0 +1,115 @@
+#ifndef LATENCY_TRACE_H
+#define LATENCY_TRACE_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "frame_encoder.h"
+
+// === Trace latensi per sampel (sisi slave) ===
+// Setiap sampel yang dikirim ke master membawa:
+//
+//   SEQ:<n>   nomor urut, naik monoton per slave (gap di master = frame hilang,
+//             mundur jauh = slave reboot). Frame batch memakai Q0 (frame_batch.h).
+//   TS:<ms>   waktu akuisisi, millis() slave
+//   TR:<f>,<c>,<e>,<t>
+//             us sejak akuisisi saat filter, klasifikasi, encode dan transmit
+//             selesai/dimulai. Ditambahkan paling akhir, tepat sebelum kirim.
+//
+// Sinkronisasi jam (satu putaran ala NTP, tanpa mengubah jam slave):
+//
+//   master -> "SID:<id>;SYNC:<t0>\n"                    t0 = jam master
+//   slave  -> "SID:<id>;SYNC:<t0>;T1:<t1>;T2:<t2>\n"    t1 = millis() saat baris
+//             diterima, t2 = millis() saat balasan dikirim
+//
+// Master mencatat t3 saat balasan tiba, lalu menghitung offset dan RTT
+// (latency_stats.h) untuk memetakan TS slave ke jam master.
+
+enum TraceStage {
+  STAGE_ACQUIRE = 0, // sampel lengkap (setelah fetch BME280)
+  STAGE_FILTER,      // moving average diperbarui
+  STAGE_CLASSIFY,    // kondisi diklasifikasi
+  STAGE_ENCODE,      // mulai susun frame
+  STAGE_TRANSMIT,    // byte pertama ke RS485
+  STAGE_COUNT
+};
+
+#define SYNC_FRAME_MAX 64
+
+struct SampleStamp {
+  uint32_t seq;
+  uint32_t timeMs;
+  uint32_t us[STAGE_COUNT]; // micros() tiap tahap
+
+  // Sampel baru: semua tahap mulai dari waktu akuisisi
+  void begin(uint32_t nowMs, uint32_t nowUs) {
+    timeMs = nowMs;
+    for (int i = 0; i < STAGE_COUNT; i++) us[i] = nowUs;
+  }
+
+  void mark(TraceStage stage, uint32_t nowUs) { us[stage] = nowUs; }
+
+  // us sejak akuisisi
+  uint32_t since(TraceStage stage) const { return us[stage] - us[STAGE_ACQUIRE]; }
+};
+
+// Ganti '\n' penutup frame menjadi ";TR:...\n" dan catat waktu transmit.
+// Return panjang baru; jika buffer tidak cukup frame dikembalikan seperti semula.
+inline size_t appendTrace(char* out, size_t len, size_t cap, SampleStamp& s, uint32_t transmitUs)
+{
+  if (len == 0 || out[len - 1] != '\n') return len;
+  s.mark(STAGE_TRANSMIT, transmitUs);
+
+  FrameWriter w(out, cap);
+  w.len = len - 1;
+  w.puts(";TR:");
+  for (int st = STAGE_FILTER; st < STAGE_COUNT; st++) {
+    if (st > STAGE_FILTER) w.put(',');
+    w.putUnsigned(s.since((TraceStage)st));
+  }
+  w.put('\n');
+
+  if (w.overflow) {
+    out[len - 1] = '\n';
+    return len;
+  }
+  return w.len;
+}
+
+// Balasan SYNC, t0 jam master dikembalikan apa adanya (0..2^64-1).
+// Return panjang, 0 jika buffer tidak cukup.
+inline size_t encodeSyncReply(const char* sensorId, uint64_t t0, uint32_t t1, uint32_t t2, char* out, size_t cap)
+{
+  FrameWriter w(out, cap);
+  w.puts("SID:"); w.puts(sensorId); w.put(';');
+  w.fieldUnsigned("SYNC", t0);
+  w.fieldUnsigned("T1", t1);
+  w.fieldUnsigned("T2", t2, '\n');
+  return w.overflow ? 0 : w.len;
+}
+
+#endif
+
+/*
+*** Example ***
+
+#include "latency_trace.h"
+
+SampleStamp stamp;
+uint32_t seq = 0;
+
+void readData() {
+  // ... baca sensor
+  stamp.begin(millis(), micros());
+  // ... update filter
+  stamp.mark(STAGE_FILTER, micros());
+}
+
+void sendDataRS485() {
+  stamp.seq = ++seq;
+  stamp.mark(STAGE_ENCODE, micros());
+  size_t len = encodeFrame(frame, buf, sizeof(buf));
+  len = appendTrace(buf, len, sizeof(buf), stamp, micros());
+  rs485.send((const uint8_t*)buf, len);
+}
+
+*/
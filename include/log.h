@@ -0,0 +1,269 @@
+#ifndef LOG_H
+#define LOG_H
+
+// === Logging berlevel, asinkron, bisa dihapus saat compile ===
+//
+//   LOG_E / LOG_W / LOG_I / LOG_D ("format", args...)
+//
+// Level di bawah LOG_LEVEL hilang total dari binary (termasuk string format
+// dan evaluasi argumennya). Record yang aktif masuk ring lock-free lalu
+// dikirim ke Serial oleh task prioritas rendah, jadi pemanggil tidak pernah
+// menunggu UART. Jika ring penuh, record dibuang dan dihitung.
+//
+// Build flag:
+//   -D LOG_LEVEL=LOG_LEVEL_WARN   pilih level (default INFO)
+//   -D LOG_BINARY                 record biner ringkas, decode di host dengan
+//                                 tools/logdecode.py (format string tidak ikut
+//                                 terkirim, hanya hash 16-bit + argumen)
+
+#include <Arduino.h>
+#include <atomic>
+
+#define LOG_LEVEL_NONE  0
+#define LOG_LEVEL_ERROR 1
+#define LOG_LEVEL_WARN  2
+#define LOG_LEVEL_INFO  3
+#define LOG_LEVEL_DEBUG 4
+
+#ifndef LOG_LEVEL
+#define LOG_LEVEL LOG_LEVEL_INFO
+#endif
+
+#define LOG_RING_SLOTS 32      // harus pangkat 2
+#define LOG_SLOT_SIZE 120
+#define LOG_TASK_STACK 3072
+// loop() (loopTask) jalan di core 1 dengan prioritas 1. Task log dipin ke
+// core 0 agar tidak berbagi time slice dengan loop(); prioritas 1 di sana
+// berarti di atas idle, di bawah task ADC (5) dan stack Bluetooth.
+#define LOG_TASK_PRIORITY 1
+#define LOG_TASK_CORE 0
+#define LOG_DRAIN_IDLE_MS 10
+#define LOG_MAX_STRING 31      // panjang maks argumen %s di mode biner
+
+// Record biner: A5 | level | id16 | ms32 | len | args...
+#define LOG_SYNC_BYTE 0xA5
+#define LOG_ID_DROPPED 0x0000
+
+// === Ring MPSC lock-free (antrian bounded Vyukov) ===
+class LogRing {
+  private:
+    struct Slot {
+      std::atomic<uint32_t> seq;
+      uint8_t len;
+      uint8_t data[LOG_SLOT_SIZE];
+    };
+    Slot slots[LOG_RING_SLOTS];
+    std::atomic<uint32_t> head;
+    uint32_t tail; // hanya dipakai task drain
+    std::atomic<uint32_t> dropped;
+
+  public:
+    LogRing() : head(0), tail(0), dropped(0) {
+      for (uint32_t i = 0; i < LOG_RING_SLOTS; i++) slots[i].seq.store(i, std::memory_order_relaxed);
+    }
+
+    // Dipanggil dari task mana pun. Tidak pernah blok.
+    bool push(const uint8_t* data, size_t len) {
+      if (len > LOG_SLOT_SIZE) len = LOG_SLOT_SIZE;
+      uint32_t pos = head.load(std::memory_order_relaxed);
+      Slot* slot;
+      for (;;) {
+        slot = &slots[pos & (LOG_RING_SLOTS - 1)];
+        int32_t diff = (int32_t)(slot->seq.load(std::memory_order_acquire) - pos);
+        if (diff == 0) {
+          if (head.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) break;
+        } else if (diff < 0) {
+          dropped.fetch_add(1, std::memory_order_relaxed);
+          return false; // penuh
+        } else {
+          pos = head.load(std::memory_order_relaxed);
+        }
+      }
+      memcpy(slot->data, data, len);
+      slot->len = (uint8_t)len;
+      slot->seq.store(pos + 1, std::memory_order_release);
+      return true;
+    }
+
+    // Hanya dari satu consumer. Return panjang record, 0 jika kosong.
+    size_t pop(uint8_t* out) {
+      Slot* slot = &slots[tail & (LOG_RING_SLOTS - 1)];
+      if (slot->seq.load(std::memory_order_acquire) != tail + 1) return 0;
+      size_t len = slot->len;
+      memcpy(out, slot->data, len);
+      slot->seq.store(tail + LOG_RING_SLOTS, std::memory_order_release);
+      tail++;
+      return len;
+    }
+
+    uint32_t getDropped() { return dropped.load(std::memory_order_relaxed); }
+};
+
+inline LogRing& logRing()
+{
+  static LogRing ring;
+  return ring;
+}
+
+// === Hash format string (FNV-1a 32-bit dilipat ke 16-bit), dihitung saat compile ===
+constexpr uint32_t logFnv(const char* s, uint32_t h = 2166136261u)
+{
+  return *s ? logFnv(s + 1, (h ^ (uint8_t)*s) * 16777619u) : h;
+}
+constexpr uint16_t logId(const char* s)
+{
+  return (uint16_t)((logFnv(s) >> 16) ^ (logFnv(s) & 0xFFFF));
+}
+
+#ifdef LOG_BINARY
+
+// === Packing argumen biner ===
+struct LogPacker {
+  uint8_t buf[LOG_SLOT_SIZE];
+  size_t len;
+
+  void put(const void* p, size_t n) {
+    if (len + n > LOG_SLOT_SIZE) n = LOG_SLOT_SIZE - len;
+    memcpy(buf + len, p, n);
+    len += n;
+  }
+  void put32(uint32_t v) { put(&v, 4); } // ESP32 little-endian
+};
+
+inline void logPack(LogPacker& p, int v) { p.put32((uint32_t)v); }
+inline void logPack(LogPacker& p, unsigned v) { p.put32(v); }
+inline void logPack(LogPacker& p, long v) { p.put32((uint32_t)v); }
+inline void logPack(LogPacker& p, unsigned long v) { p.put32((uint32_t)v); }
+inline void logPack(LogPacker& p, long long v) { p.put(&v, 8); }
+inline void logPack(LogPacker& p, unsigned long long v) { p.put(&v, 8); }
+inline void logPack(LogPacker& p, double v) { float f = (float)v; p.put(&f, 4); }
+// strnlen: buffer "%.*s" tidak wajib diakhiri '\0', presisinya dipakai decoder
+inline void logPack(LogPacker& p, const char* s) {
+  size_t n = s ? strnlen(s, LOG_MAX_STRING) : 0;
+  uint8_t n8 = (uint8_t)n;
+  p.put(&n8, 1);
+  p.put(s, n);
+}
+
+inline void logPackAll(LogPacker&) {}
+template <typename T, typename... Rest>
+inline void logPackAll(LogPacker& p, T first, Rest... rest)
+{
+  logPack(p, first);
+  logPackAll(p, rest...);
+}
+
+template <typename... Args>
+inline void logWrite(uint8_t level, uint16_t id, Args... args)
+{
+  LogPacker p;
+  p.len = 0;
+  uint32_t ms = millis();
+  uint8_t header[4] = { LOG_SYNC_BYTE, level, (uint8_t)(id & 0xFF), (uint8_t)(id >> 8) };
+  p.put(header, 4);
+  p.put32(ms);
+  p.len++; // tempat panjang argumen
+  logPackAll(p, args...);
+  p.buf[8] = (uint8_t)(p.len - 9);
+  logRing().push(p.buf, p.len);
+}
+
+// id dipaksa konstanta compile-time agar string format tidak masuk binary
+#define LOG_AT(level, fmt, ...) do { \
+    constexpr uint16_t logRecordId = logId(fmt); \
+    logWrite(level, logRecordId, ##__VA_ARGS__); \
+  } while (0)
+
+#else
+
+inline void logText(uint8_t level, const char* fmt, ...) __attribute__((format(printf, 2, 3)));
+
+// Format langsung ke slot ring: "<L> <ms> | pesan\n"
+inline void logText(uint8_t level, const char* fmt, ...)
+{
+  static const char levelChar[] = "-EWID";
+  char buf[LOG_SLOT_SIZE];
+  int n = snprintf(buf, sizeof(buf), "%c %lu | ", levelChar[level], (unsigned long)millis());
+  va_list args;
+  va_start(args, fmt);
+  int m = vsnprintf(buf + n, sizeof(buf) - n - 1, fmt, args);
+  va_end(args);
+  size_t len = n + (m < 0 ? 0 : m);
+  if (len > sizeof(buf) - 2) len = sizeof(buf) - 2;
+  if (len == 0 || buf[len - 1] != '\n') buf[len++] = '\n';
+  logRing().push((const uint8_t*)buf, len);
+}
+
+#define LOG_AT(level, fmt, ...) logText(level, fmt, ##__VA_ARGS__)
+
+#endif
+
+// === Makro per level ===
+#if LOG_LEVEL >= LOG_LEVEL_ERROR
+#define LOG_E(fmt, ...) LOG_AT(LOG_LEVEL_ERROR, fmt, ##__VA_ARGS__)
+#else
+#define LOG_E(...) do {} while (0)
+#endif
+
+#if LOG_LEVEL >= LOG_LEVEL_WARN
+#define LOG_W(fmt, ...) LOG_AT(LOG_LEVEL_WARN, fmt, ##__VA_ARGS__)
+#else
+#define LOG_W(...) do {} while (0)
+#endif
+
+#if LOG_LEVEL >= LOG_LEVEL_INFO
+#define LOG_I(fmt, ...) LOG_AT(LOG_LEVEL_INFO, fmt, ##__VA_ARGS__)
+#else
+#define LOG_I(...) do {} while (0)
+#endif
+
+#if LOG_LEVEL >= LOG_LEVEL_DEBUG
+#define LOG_D(fmt, ...) LOG_AT(LOG_LEVEL_DEBUG, fmt, ##__VA_ARGS__)
+#else
+#define LOG_D(...) do {} while (0)
+#endif
+
+// === Task drain: ring -> Serial ===
+inline void logDrainTask(void* arg)
+{
+  uint8_t record[LOG_SLOT_SIZE];
+  uint32_t reportedDrops = 0;
+  for (;;) {
+    size_t len;
+    bool any = false;
+    while ((len = logRing().pop(record)) > 0) {
+      Serial.write(record, len);
+      any = true;
+    }
+
+    uint32_t drops = logRing().getDropped();
+    if (drops != reportedDrops) {
+#ifdef LOG_BINARY
+      uint8_t rec[13] = { LOG_SYNC_BYTE, 0, LOG_ID_DROPPED & 0xFF, LOG_ID_DROPPED >> 8 };
+      uint32_t ms = millis();
+      memcpy(rec + 4, &ms, 4);
+      rec[8] = 4;
+      memcpy(rec + 9, &drops, 4);
+      Serial.write(rec, sizeof(rec));
+#else
+      Serial.printf("W %lu | log: %u record dibuang\n", (unsigned long)millis(), (unsigned)drops);
+#endif
+      reportedDrops = drops;
+    }
+
+    if (!any) vTaskDelay(pdMS_TO_TICKS(LOG_DRAIN_IDLE_MS));
+  }
+}
+
+// Jalankan task drain. Record sebelum ini tetap tersimpan di ring.
+inline void logBegin()
+{
+  xTaskCreatePinnedToCore(logDrainTask, "log", LOG_TASK_STACK, NULL, LOG_TASK_PRIORITY, NULL, LOG_TASK_CORE);
+}
+
+inline uint32_t logDropped()
+{
+  return logRing().getDropped();
+}
+
+#endif
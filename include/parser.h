@@ -1,42 +1,236 @@
 #ifndef PARSER_H
 #define PARSER_H
 
-#include <Arduino.h>
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+#include <limits.h>
 
-char** parse(char* input, const char* delim, int maxBuffer = 5)
+// === Tokenizer tanpa alokasi ===
+// Token berupa span (pointer, panjang) ke buffer milik pemanggil, jadi input
+// tidak diubah dan tidak ada heap. Tidak memakai state global (reentrant),
+// aman dipanggil dari beberapa task sekaligus.
+
+struct TokenSpan {
+  const char* ptr;
+  uint16_t len;
+};
+
+inline bool isDelim(char c, const char* delims)
 {
-  if (input == NULL || delim == NULL) return NULL;
+  for (const char* d = delims; *d; d++) if (*d == c) return true;
+  return false;
+}
 
-  char** buffer = (char**)calloc(maxBuffer, sizeof(char*));
-  if (!buffer) {
-    Serial.println("❌ Gagal mengalokasikan memori untuk buffer parse");
-    return NULL;
+// Pecah input menjadi token (delimiter beruntun dilewati seperti strtok).
+// Return jumlah token yang ditulis ke out, maksimal cap.
+inline size_t tokenize(const char* input, size_t len, const char* delims, TokenSpan* out, size_t cap)
+{
+  size_t count = 0;
+  size_t i = 0;
+  while (i < len && count < cap) {
+    while (i < len && isDelim(input[i], delims)) i++;
+    if (i >= len) break;
+    size_t start = i;
+    while (i < len && !isDelim(input[i], delims)) i++;
+    out[count].ptr = input + start;
+    out[count].len = (uint16_t)(i - start);
+    count++;
   }
+  return count;
+}
 
-  int index = 0;
-  char* token = strtok(input, delim);
-  while (token != NULL && index < maxBuffer - 1) {
-    buffer[index] = strdup(token); 
-    if (!buffer[index]) {
-      Serial.printf("❌ Gagal alokasi untuk token ke-%d\n", index);
-      for (int j = 0; j < index; j++) free(buffer[j]);
-      free(buffer);
-      return NULL;
-    }
-    index++;
-    token = strtok(NULL, delim);
+// Array token berkapasitas tetap, cukup ditaruh di stack
+template <size_t N>
+struct TokenList {
+  TokenSpan tokens[N];
+  size_t count;
+
+  size_t split(const char* input, size_t len, const char* delims) {
+    count = tokenize(input, len, delims, tokens, N);
+    return count;
+  }
+  const TokenSpan& operator[](size_t i) const { return tokens[i]; }
+};
+
+// === Helper span ===
+inline bool spanEquals(const TokenSpan& s, const char* str)
+{
+  size_t n = strlen(str);
+  return s.len == n && memcmp(s.ptr, str, n) == 0;
+}
+
+inline int spanCompare(const char* a, size_t aLen, const char* b)
+{
+  size_t bLen = strlen(b);
+  int c = memcmp(a, b, aLen < bLen ? aLen : bLen);
+  if (c != 0) return c;
+  return (int)aLen - (int)bLen;
+}
+
+// Parse integer desimal (boleh bertanda). Return false jika bukan angka
+// atau di luar jangkauan long (input dari bus tidak boleh overflow).
+inline bool spanToLong(const TokenSpan& s, long& out)
+{
+  if (s.len == 0) return false;
+  size_t i = 0;
+  bool neg = false;
+  if (s.ptr[0] == '-' || s.ptr[0] == '+') { neg = s.ptr[0] == '-'; i++; }
+  if (i >= s.len) return false;
+  long v = 0;
+  for (; i < s.len; i++) {
+    if (s.ptr[i] < '0' || s.ptr[i] > '9') return false;
+    int d = s.ptr[i] - '0';
+    if (v > (LONG_MAX - d) / 10) return false;
+    v = v * 10 + d;
   }
+  out = neg ? -v : v;
+  return true;
+}
 
-  return buffer;
+// Parse integer desimal tanpa tanda sampai 64 bit (cap waktu master,
+// nomor urut). Return false jika bukan angka atau overflow uint64_t.
+inline bool spanToUnsigned(const TokenSpan& s, uint64_t& out)
+{
+  if (s.len == 0) return false;
+  uint64_t v = 0;
+  for (size_t i = 0; i < s.len; i++) {
+    if (s.ptr[i] < '0' || s.ptr[i] > '9') return false;
+    int d = s.ptr[i] - '0';
+    if (v > (UINT64_MAX - d) / 10) return false;
+    v = v * 10 + d;
+  }
+  out = v;
+  return true;
 }
 
-void freeParse(char** buffer, int maxBuffer)
+// Parse angka desimal sederhana "[-]123.45"
+inline bool spanToFloat(const TokenSpan& s, float& out)
+{
+  if (s.len == 0) return false;
+  size_t i = 0;
+  bool neg = false;
+  if (s.ptr[0] == '-' || s.ptr[0] == '+') { neg = s.ptr[0] == '-'; i++; }
+  float v = 0, scale = 1;
+  bool digits = false, frac = false;
+  for (; i < s.len; i++) {
+    char c = s.ptr[i];
+    if (c == '.' && !frac) { frac = true; continue; }
+    if (c < '0' || c > '9') return false;
+    digits = true;
+    if (frac) { scale /= 10; v += (c - '0') * scale; }
+    else v = v * 10 + (c - '0');
+  }
+  if (!digits) return false;
+  out = neg ? -v : v;
+  return true;
+}
+
+// === Dispatcher KEY:VAL; ===
+// Key dengan akhiran angka (TEMP1, TEMP2, ...) dicocokkan ke entry dasarnya
+// ("TEMP") dan angkanya diteruskan sebagai index (-1 jika tanpa angka).
+
+typedef void (*CommandHandler)(int index, const TokenSpan& value, void* ctx);
+
+struct CommandEntry {
+  const char* key;
+  CommandHandler handler;
+};
+
+// Tabel HARUS terurut (strcmp) karena dicari dengan binary search
+inline bool isCommandTableSorted(const CommandEntry* table, size_t count)
 {
-  if (!buffer) return;
-  for (int i = 0; i < maxBuffer; i++) {
-    if (buffer[i]) free(buffer[i]);
+  for (size_t i = 1; i < count; i++) {
+    if (strcmp(table[i - 1].key, table[i].key) >= 0) return false;
   }
-  free(buffer);
+  return true;
+}
+
+inline const CommandEntry* findCommand(const char* key, size_t len, const CommandEntry* table, size_t count)
+{
+  size_t lo = 0, hi = count;
+  while (lo < hi) {
+    size_t mid = (lo + hi) / 2;
+    int c = spanCompare(key, len, table[mid].key);
+    if (c == 0) return &table[mid];
+    if (c < 0) hi = mid;
+    else lo = mid + 1;
+  }
+  return NULL;
+}
+
+// Satu kali lintas: "KEY:VAL;KEY:VAL\n" langsung di-dispatch tanpa salinan.
+// Field tanpa ':' atau key yang tidak dikenal dilewati.
+// Return jumlah field yang ditangani.
+inline int dispatchKeyValues(const char* input, size_t len, const CommandEntry* table, size_t count, void* ctx)
+{
+  int handled = 0;
+  size_t i = 0;
+  while (i < len) {
+    size_t start = i;
+    size_t colon = len;
+    while (i < len && input[i] != ';' && input[i] != '\n' && input[i] != '\r') {
+      if (input[i] == ':' && colon == len) colon = i;
+      i++;
+    }
+    size_t end = i;
+    i++; // lewati pemisah
+
+    if (colon == len || colon >= end) continue;
+
+    // Pisahkan akhiran angka pada key
+    size_t keyEnd = colon;
+    while (keyEnd > start && input[keyEnd - 1] >= '0' && input[keyEnd - 1] <= '9') keyEnd--;
+    int index = -1;
+    const CommandEntry* entry = findCommand(input + start, colon - start, table, count);
+    if (!entry && keyEnd < colon && keyEnd > start) {
+      entry = findCommand(input + start, keyEnd - start, table, count);
+      index = 0;
+      for (size_t k = keyEnd; k < colon && entry; k++) {
+        int d = input[k] - '0';
+        if (index > (INT_MAX - d) / 10) entry = NULL; // index kebesaran, field dilewati
+        else index = index * 10 + d;
+      }
+    }
+    if (!entry) continue;
+
+    TokenSpan value = { input + colon + 1, (uint16_t)(end - colon - 1) };
+    entry->handler(index, value, ctx);
+    handled++;
+  }
+  return handled;
+}
+
+#endif
+
+/*
+*** Example ***
+
+#include "parser.h"
+
+struct Reading { int gas; float temps[4]; };
+
+void onGas(int, const TokenSpan& v, void* ctx) {
+  long n;
+  if (spanToLong(v, n)) ((Reading*)ctx)->gas = n;
+}
+
+void onTemp(int index, const TokenSpan& v, void* ctx) {
+  if (index >= 1 && index <= 4) spanToFloat(v, ((Reading*)ctx)->temps[index - 1]);
+}
+
+const CommandEntry table[] = {   // terurut!
+  { "GAS",  onGas  },
+  { "TEMP", onTemp },
+};
+
+void loop() {
+  const char line[] = "SID:abc;GAS:512;TEMP1:25.50;TEMP2:26.00\n";
+  Reading r;
+  dispatchKeyValues(line, strlen(line), table, 2, &r);
+
+  TokenList<8> fields;
+  fields.split(line, strlen(line), ";\n");
 }
 
-#endif
\ No newline at end of file
+*/
@@ -0,0 +1,21 @@
+#ifndef SAMPLE_TYPE_H
+#define SAMPLE_TYPE_H
+
+#include <SignalProcessing.h>
+#include "frame_encoder.h"
+
+// === Tipe numerik jalur sampel -> klasifikasi -> frame ===
+// Default float. Dengan -D FIXED_POINT_BUILD seluruh jalur (arena, moving
+// average, klasifikasi, encoder frame) memakai Q16.16 integer saja; nilai
+// sensor dikonversi sekali saat masuk. Rentang Q16.16 (±32768) cukup untuk
+// suhu, kelembapan dan tekanan hPa; jumlah moving average dihitung 64-bit.
+#ifdef FIXED_POINT_BUILD
+typedef q16_16 sample_t;
+#else
+typedef float sample_t;
+#endif
+
+typedef basicMovingAverage<sample_t> sampleAverage;
+typedef basicFrameData<sample_t> SampleFrame;
+
+#endif
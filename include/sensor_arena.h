@@ -0,0 +1,81 @@
+#ifndef SENSOR_ARENA_H
+#define SENSOR_ARENA_H
+
+#include <stdlib.h>
+#include <stddef.h>
+#include "sample_type.h"
+
+// === Arena data sensor ===
+// Semua ring moving average dalam SATU alokasi kontigu (sekali saat boot):
+//
+//   [ ring 0: depth ][ ring 1: depth ] ...
+//
+// Jika alokasi gagal, ring dilepas satu per satu dari belakang, tanpa hang.
+// Ring yang tidak kebagian tempat dinonaktifkan (ring() = nullptr).
+// Elemen bertipe sample_t (float, atau Q16.16 pada FIXED_POINT_BUILD).
+
+#define ARENA_MAX_RINGS 8
+
+class SensorArena {
+  private:
+    sample_t* block;
+    int depth;
+    int ringChannels;
+
+  public:
+    SensorArena() : block(nullptr), depth(0), ringChannels(0) {}
+    ~SensorArena() { if (block) free(block); }
+
+    // Alokasikan arena. Return false jika ada ring yang dinonaktifkan.
+    bool begin(int bufferDepth, int rings) {
+      if (block) free(block);
+      block = nullptr;
+      depth = bufferDepth;
+      if (rings > ARENA_MAX_RINGS) rings = ARENA_MAX_RINGS;
+      int wantRings = rings;
+
+      while (rings > 0) {
+        size_t items = (size_t)depth * rings;
+        if (items == 0) break;
+        block = (sample_t*)calloc(items, sizeof(sample_t));
+        if (block) break;
+        rings--;
+      }
+      if (!block) rings = 0;
+
+      ringChannels = rings;
+      return ringChannels == wantRings;
+    }
+
+    // Storage ring ke-i untuk sampleAverage::init(sample_t*), nullptr jika nonaktif
+    sample_t* ring(int i) {
+      if (!block || i < 0 || i >= ringChannels) return nullptr;
+      return block + (size_t)i * depth;
+    }
+
+    int getRingChannels() { return ringChannels; }
+    int getDepth() { return depth; }
+
+    // Total memori arena dalam byte (data + objek arena)
+    size_t footprint() {
+      return (size_t)depth * ringChannels * sizeof(sample_t) + sizeof(*this);
+    }
+};
+
+#endif
+
+/*
+*** Example ***
+
+#include "sensor_arena.h"
+
+SensorArena arena;
+sampleAverage humidity(25);
+
+void setup() {
+  arena.begin(25, 1);           // 25 sampel, 1 ring
+  humidity.init(arena.ring(0)); // ring tanpa malloc sendiri
+  Serial.printf("Arena %u byte\n", (unsigned)arena.footprint());
+}
+
+*/
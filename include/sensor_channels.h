@@ -0,0 +1,105 @@
+#ifndef SENSOR_CHANNELS_H
+#define SENSOR_CHANNELS_H
+
+#include <stdint.h>
+#include "sensor_config.h"
+#include "sample_type.h"
+
+// === Layout channel sensor ===
+// Setiap driver (sensor_driver.h) menulis ke rentang channelnya sendiri di
+// ChannelBank; klasifikasi, frame, stream dan trace hanya membaca bank.
+// Suhu DS18B20 berdampingan sehingga bisa dipakai langsung sebagai array.
+
+#ifndef DS18B20_MAX_SENSORS
+#define DS18B20_MAX_SENSORS expectedSensorCount
+#endif
+
+enum SensorChannel {
+  CH_GAS = 0,                            // MQ2 raw ADC, skala MQ_ADC_BITS
+  CH_CO,                                 // MQ7 ppm (latch tiap siklus heater)
+  CH_TEMP0,                              // DS18B20 slot 0..N-1
+  CH_HUMIDITY = CH_TEMP0 + DS18B20_MAX_SENSORS,
+  CH_PRESSURE,                           // hPa
+  CH_AMBIENT,                            // suhu BME280
+  CH_COUNT
+};
+
+// === Nilai terbaru tiap channel ===
+// raw = nilai terakhir dari driver, value = setelah filter (moving average)
+// jika channel punya filter, selain itu sama dengan raw. Channel yang belum
+// pernah diisi bernilai tidak valid.
+class ChannelBank {
+  private:
+    sample_t raw[CH_COUNT];
+    sample_t value[CH_COUNT];
+    sampleAverage* filters[CH_COUNT];
+    uint32_t updatedMs[CH_COUNT];
+    bool dirty[CH_COUNT];
+
+  public:
+    ChannelBank() {
+      for (int ch = 0; ch < CH_COUNT; ch++) filters[ch] = nullptr;
+      clear();
+    }
+
+    void clear() {
+      for (int ch = 0; ch < CH_COUNT; ch++) {
+        raw[ch] = value[ch] = sampleTraits<sample_t>::invalid();
+        updatedMs[ch] = 0;
+        dirty[ch] = false;
+      }
+    }
+
+    // Pasang moving average untuk channel (nullptr = tanpa filter)
+    void attachFilter(int ch, sampleAverage* filter) { filters[ch] = filter; }
+
+    // Dipanggil driver saat ada pembacaan baru
+    void set(int ch, sample_t v, uint32_t nowMs) {
+      raw[ch] = v;
+      updatedMs[ch] = nowMs;
+      dirty[ch] = true;
+    }
+
+    // Jalankan filter untuk channel yang baru diisi. Return jumlah channel.
+    int filter() {
+      int n = 0;
+      for (int ch = 0; ch < CH_COUNT; ch++) {
+        if (!dirty[ch]) continue;
+        dirty[ch] = false;
+        n++;
+        if (!filters[ch]) value[ch] = raw[ch];
+        else if (isValidSample(raw[ch])) value[ch] = filters[ch]->update(raw[ch]);
+      }
+      return n;
+    }
+
+    sample_t get(int ch) const { return value[ch]; }
+    sample_t getRaw(int ch) const { return raw[ch]; }
+    int getInt(int ch) const { return sampleToInt(value[ch]); } // tidak valid = 0
+    const sample_t* row(int ch) const { return &value[ch]; }
+    uint32_t getUpdatedMs(int ch) const { return updatedMs[ch]; }
+};
+
+#endif
+
+/*
+*** Example ***
+
+#include "sensor_channels.h"
+
+ChannelBank channels;
+sampleAverage humidity(25);
+
+void setup() {
+  humidity.init();
+  channels.attachFilter(CH_HUMIDITY, &humidity);
+}
+
+void loop() {
+  channels.set(CH_HUMIDITY, 55.2f, millis()); // dari driver
+  channels.filter();
+  float h = toFloat(channels.get(CH_HUMIDITY)); // rata-rata bergerak
+  const sample_t* temps = channels.row(CH_TEMP0);
+}
+
+*/
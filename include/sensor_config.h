@@ -0,0 +1,29 @@
+#ifndef SENSOR_CONFIG_H
+#define SENSOR_CONFIG_H
+
+// === Konfigurasi akuisisi bersama (firmware & replay host) ===
+#define intervalDataRead 500 // periode frame RS485
+#define expectedSensorCount 4
+#define DATA_BUFFER_SIZE 25
+#define DATA_READ_PER_INTERVAL 2
+
+// === Jadwal driver sensor (lihat sensor_driver.h) ===
+#define MQ2_PERIOD_MS (intervalDataRead / DATA_READ_PER_INTERVAL)
+#define MQ2_WARMUP_MS 20000    // pemanasan elemen, pembacaan awal tidak stabil
+#define MQ7_PERIOD_MS 500      // menggerakkan siklus heater (jendela sampel 2 s), ppm baru tiap 150 s
+#define MQ7_WARMUP_MS 0        // siklus heater sendiri yang menahan pembacaan
+#define DS18B20_PERIOD_MS 1000 // konversi 12-bit 750 ms
+#define BME280_PERIOD_MS 1000
+#define SENSOR_IDLE_MAX_MS 20  // jeda maksimum loop() saat tidak ada driver jatuh tempo
+
+// === Batching frame RS485 (bisa diubah master: BN:<n>, BW:<ms>) ===
+#define FRAME_BATCH_SIZE 1         // 1 = mati, satu snapshot per frame
+#define FRAME_BATCH_WINDOW_MS 5000 // kirim batch paling lambat setelah ini
+
+// === ADC oversampling (aktif dengan -D ADC_OVERSAMPLING) ===
+// Total konversi/detik semua channel; minimum DMA ESP32 adalah 20 kHz.
+#define ADC_SAMPLE_RATE_HZ 20000
+#define ADC_CIC_ORDER 2
+#define ADC_CIC_LOG2_DECIMATION 8 // 10 kHz/channel / 256 -> ~39 Hz, 16-bit
+
+#endif
@@ -0,0 +1,176 @@
+#ifndef SENSOR_DRIVER_H
+#define SENSOR_DRIVER_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "sensor_channels.h"
+
+// === Antarmuka driver sensor + scheduler deadline ===
+// Setiap driver mendeklarasikan sendiri periode baca, waktu warm-up dan
+// rentang channel yang ditulisnya di ChannelBank. Registry adalah tabel
+// konstan di main.cpp (seperti masterCommands), sehingga menambah sensor =
+// satu driver + satu baris tabel + channelnya di sensor_channels.h.
+//
+// Scheduler hanya mem-poll driver yang jatuh tempo, urut deadline terdekat,
+// dan mencatat biaya (us) tiap poll per driver. Driver dua tahap (mulai
+// konversi, ambil hasil) meminta poll lanjutan lebih cepat lewat nextMs.
+// Murni C++ tanpa Arduino: driver palsu (sensor_fakes.h) jalan di Linux.
+
+#define SENSOR_MAX_DRIVERS 8
+
+class SensorDriver {
+  public:
+    const char* const name;
+    const uint32_t periodMs;
+    const uint32_t warmupMs;   // poll pertama setelah begin() + warmupMs
+    const uint8_t firstChannel;
+    const uint8_t channelCount;
+
+    SensorDriver(const char* driverName, uint32_t period, uint32_t warmup, uint8_t first, uint8_t count)
+      : name(driverName), periodMs(period), warmupMs(warmup), firstChannel(first), channelCount(count) {}
+    virtual ~SensorDriver() {}
+
+    // Init hardware. false = sensor tidak ada, driver tidak dijadwalkan.
+    virtual bool begin(uint32_t nowMs) = 0;
+
+    // Satu langkah baca, hasil ditulis ke channel milik driver. nextMs sudah
+    // diisi deadline periodik berikutnya; boleh dimajukan (mis. ambil hasil
+    // konversi). Return true jika ada pembacaan baru di bank.
+    virtual bool poll(uint32_t nowMs, ChannelBank& bank, uint32_t& nextMs) = 0;
+};
+
+struct SensorDriverStats {
+  uint32_t polls;
+  uint32_t samples;   // poll yang menghasilkan pembacaan
+  uint64_t totalUs;   // biaya CPU kumulatif
+  uint32_t maxUs;
+  uint32_t maxLateMs; // keterlambatan terburuk terhadap deadline
+  uint32_t overruns;  // terlambat lebih dari satu periode (jadwal digeser)
+};
+
+class SensorScheduler {
+  private:
+    SensorDriver* const* drivers;
+    size_t count;
+    uint32_t (*clockUs)();
+    uint32_t due[SENSOR_MAX_DRIVERS];
+    bool active[SENSOR_MAX_DRIVERS];
+    SensorDriverStats stats[SENSOR_MAX_DRIVERS];
+
+  public:
+    // clock: sumber us untuk biaya poll (micros() di ESP32, jam palsu di host)
+    SensorScheduler(SensorDriver* const* table, size_t n, uint32_t (*clock)())
+      : drivers(table), count(n > SENSOR_MAX_DRIVERS ? SENSOR_MAX_DRIVERS : n), clockUs(clock) {
+      for (size_t i = 0; i < SENSOR_MAX_DRIVERS; i++) active[i] = false;
+      resetStats();
+    }
+
+    // Init semua driver. Return jumlah driver aktif.
+    int begin(uint32_t nowMs) {
+      int n = 0;
+      for (size_t i = 0; i < count; i++) {
+        active[i] = drivers[i]->begin(nowMs);
+        due[i] = nowMs + drivers[i]->warmupMs;
+        if (active[i]) n++;
+      }
+      return n;
+    }
+
+    // Poll setiap driver yang jatuh tempo (maks sekali per panggilan), deadline
+    // terdekat dulu. Return bitmask index driver yang menghasilkan pembacaan.
+    uint32_t run(uint32_t nowMs, ChannelBank& bank) {
+      uint32_t produced = 0;
+      uint32_t polled = 0;
+      for (;;) {
+        int next = -1;
+        for (size_t i = 0; i < count; i++) {
+          if (!active[i] || (polled & (1UL << i)) || (int32_t)(nowMs - due[i]) < 0) continue;
+          if (next < 0 || (int32_t)(due[i] - due[next]) < 0) next = (int)i;
+        }
+        if (next < 0) break;
+        polled |= 1UL << next;
+
+        SensorDriver* d = drivers[next];
+        SensorDriverStats& st = stats[next];
+        uint32_t late = nowMs - due[next];
+        if (late > st.maxLateMs) st.maxLateMs = late;
+
+        // Deadline periodik dari jadwal, bukan dari waktu poll, agar tidak drift
+        uint32_t nextMs = due[next] + d->periodMs;
+        if ((int32_t)(nextMs - nowMs) <= 0) {
+          st.overruns++;
+          nextMs = nowMs + d->periodMs;
+        }
+
+        uint32_t start = clockUs();
+        bool got = d->poll(nowMs, bank, nextMs);
+        uint32_t cost = clockUs() - start;
+
+        st.polls++;
+        st.totalUs += cost;
+        if (cost > st.maxUs) st.maxUs = cost;
+        if (got) {
+          st.samples++;
+          produced |= 1UL << next;
+        }
+        due[next] = nextMs;
+      }
+      return produced;
+    }
+
+    // ms sampai deadline terdekat, dibatasi maxMs
+    uint32_t msUntilNext(uint32_t nowMs, uint32_t maxMs) {
+      uint32_t wait = maxMs;
+      for (size_t i = 0; i < count; i++) {
+        if (!active[i]) continue;
+        int32_t d = (int32_t)(due[i] - nowMs);
+        if (d <= 0) return 0;
+        if ((uint32_t)d < wait) wait = d;
+      }
+      return wait;
+    }
+
+    void resetStats() {
+      for (size_t i = 0; i < SENSOR_MAX_DRIVERS; i++) stats[i] = SensorDriverStats();
+    }
+
+    size_t getCount() { return count; }
+    SensorDriver* getDriver(size_t i) { return drivers[i]; }
+    bool isActive(size_t i) { return active[i]; }
+    const SensorDriverStats& getStats(size_t i) { return stats[i]; }
+    uint32_t avgCostUs(size_t i) {
+      return stats[i].polls ? (uint32_t)(stats[i].totalUs / stats[i].polls) : 0;
+    }
+};
+
+#endif
+
+/*
+*** Example ***
+
+#include "sensor_driver.h"
+
+class LightDriver : public SensorDriver {
+  public:
+    LightDriver() : SensorDriver("LDR", 200, 0, CH_GAS, 1) {}
+    bool begin(uint32_t) { return true; }
+    bool poll(uint32_t now, ChannelBank& bank, uint32_t&) {
+      bank.set(firstChannel, sample_t(analogRead(36)), now);
+      return true;
+    }
+};
+
+LightDriver light;
+SensorDriver* const drivers[] = { &light };
+uint32_t clockUs() { return micros(); }
+SensorScheduler scheduler(drivers, 1, clockUs);
+ChannelBank channels;
+
+void setup() { scheduler.begin(millis()); }
+
+void loop() {
+  if (scheduler.run(millis(), channels)) channels.filter();
+  delay(scheduler.msUntilNext(millis(), 50));
+}
+
+*/
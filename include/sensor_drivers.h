@@ -0,0 +1,167 @@
+#ifndef SENSOR_DRIVERS_H
+#define SENSOR_DRIVERS_H
+
+#include <Arduino.h>
+#include <MQ2.h>
+#include <MQ7.h>
+#include "sensor_config.h"
+#include "sensor_driver.h"
+#include "ds18b20_bus.h"
+#include "bme280_burst.h"
+
+// === Driver sensor hardware (MQ2, MQ7, DS18B20, BME280) ===
+// Pembungkus tipis kelas sensor yang sudah ada; periode dan warm-up dari
+// sensor_config.h. Versi palsu untuk Linux ada di sensor_fakes.h.
+
+// === MQ2: raw ADC, pembaca diganti saat ADC_OVERSAMPLING ===
+// Channel gas tetap berskala MQ_ADC_BITS (ambang klasifikasi & frame), bit
+// tambahan pembacaan oversampling disimpan sebagai pecahan. Ro dikalibrasi
+// bertahap di poll pertama setelah warm-up (heater sudah panas), lewat
+// pembaca MQ2 yang sama, jadi tidak ada analogRead() di ADC1 selama DMA.
+class MQ2Driver : public SensorDriver {
+  private:
+    MQ2& mq2;
+    uint16_t (*reader)();
+    float scale;
+
+  public:
+    MQ2Driver(MQ2& sensor, uint16_t (*readRaw)(), uint8_t bits = MQ_ADC_BITS)
+      : SensorDriver("MQ2", MQ2_PERIOD_MS, MQ2_WARMUP_MS, CH_GAS, 1), mq2(sensor), reader(readRaw),
+        scale(bits >= MQ_ADC_BITS ? 1.0f / (1UL << (bits - MQ_ADC_BITS))
+                                  : (float)(1UL << (MQ_ADC_BITS - bits))) {} // pembaca < MQ_ADC_BITS diskalakan naik
+
+    bool begin(uint32_t nowMs) {
+      mq2.close(); // Ro belum ada sampai warm-up selesai
+      return true;
+    }
+
+    bool poll(uint32_t nowMs, ChannelBank& bank, uint32_t& nextMs) {
+      if (!mq2.isCalibrated()) mq2.calibrateStep(); // satu sampel per poll, tanpa delay()
+      bank.set(CH_GAS, sample_t(reader() * scale), nowMs);
+      return true;
+    }
+};
+
+// === MQ7: menggerakkan siklus heater, ppm baru setiap akhir fase rendah ===
+class MQ7Driver : public SensorDriver {
+  private:
+    MQ7& mq7;
+
+  public:
+    MQ7Driver(MQ7& sensor)
+      : SensorDriver("MQ7", MQ7_PERIOD_MS, MQ7_WARMUP_MS, CH_CO, 1), mq7(sensor) {}
+
+    bool begin(uint32_t nowMs) {
+      mq7.begin(nowMs);
+      return true;
+    }
+
+    bool poll(uint32_t nowMs, ChannelBank& bank, uint32_t& nextMs) {
+      if (!mq7.update(nowMs)) return false;
+      bank.set(CH_CO, sample_t(mq7.getPPM()), nowMs);
+      return true;
+    }
+};
+
+// === DS18B20: konversi non-blocking, dua tahap per periode ===
+// Tahap 1 mulai konversi (skip ROM), tahap 2 membaca semua slot setelah
+// waktu konversi resolusi aktif, lalu satu langkah rescan hot-plug.
+class DS18B20Driver : public SensorDriver {
+  private:
+    DS18B20Bus& bus;
+    DallasTemperature& dallas;
+    bool converting;
+    uint32_t cycleNext; // deadline periodik siklus berikutnya
+
+  public:
+    DS18B20Driver(DS18B20Bus& b, DallasTemperature& d)
+      : SensorDriver("DS18B20", DS18B20_PERIOD_MS, 0, CH_TEMP0, DS18B20_MAX_SENSORS),
+        bus(b), dallas(d), converting(false), cycleNext(0) {}
+
+    bool begin(uint32_t nowMs) {
+      bus.begin(); // probe boleh belum ada, slot diisi saat rescan
+      dallas.setWaitForConversion(false);
+      return true;
+    }
+
+    bool poll(uint32_t nowMs, ChannelBank& bank, uint32_t& nextMs) {
+      if (!converting) {
+        bus.requestConversion();
+        converting = true;
+        cycleNext = nextMs;
+        nextMs = nowMs + dallas.millisToWaitForConversion(dallas.getResolution());
+        return false;
+      }
+      converting = false;
+      float temps[DS18B20_MAX_SENSORS];
+      bus.readAll(temps, nowMs); // gagal/skip = NAN
+      for (int i = 0; i < DS18B20_MAX_SENSORS; i++) bank.set(CH_TEMP0 + i, sample_t(temps[i]), nowMs);
+      bus.service(nowMs);
+      nextMs = cycleNext;
+      return true;
+    }
+};
+
+// === BME280: forced mode, trigger lalu fetch setelah waktu ukur ===
+class BME280Driver : public SensorDriver {
+  private:
+    BME280Burst& bme;
+    uint8_t address;
+    const BME280Config& config;
+    bool measuring;
+    uint32_t cycleNext;
+    uint32_t failures;
+
+  public:
+    BME280Driver(BME280Burst& sensor, uint8_t addr, const BME280Config& cfg)
+      : SensorDriver("BME280", BME280_PERIOD_MS, 0, CH_HUMIDITY, 3),
+        bme(sensor), address(addr), config(cfg), measuring(false), cycleNext(0), failures(0) {}
+
+    bool begin(uint32_t nowMs) { return bme.begin(address, config); }
+
+    bool poll(uint32_t nowMs, ChannelBank& bank, uint32_t& nextMs) {
+      if (!measuring) {
+        if (!bme.startMeasurement()) {
+          failures++;
+          return false;
+        }
+        measuring = true;
+        cycleNext = nextMs;
+        nextMs = nowMs + bme.measurementTimeMs();
+        return false;
+      }
+      measuring = false;
+      nextMs = cycleNext;
+      BME280Reading r;
+      if (!bme.fetch(r)) {
+        failures++;
+        return false; // channel tetap nilai terakhir
+      }
+      bank.set(CH_HUMIDITY, sample_t(r.humidity), nowMs);
+      bank.set(CH_PRESSURE, sample_t(r.pressure), nowMs);
+      bank.set(CH_AMBIENT, sample_t(r.temperature), nowMs);
+      return true;
+    }
+
+    uint32_t getFailures() { return failures; }
+};
+
+#endif
+
+/*
+*** Example ***
+
+#include "sensor_drivers.h"
+
+MQ2 mq2(34);
+uint16_t readMQ2() { return analogRead(34); }
+MQ2Driver mq2Driver(mq2, readMQ2);
+SensorDriver* const drivers[] = { &mq2Driver };
+uint32_t clockUs() { return micros(); }
+SensorScheduler scheduler(drivers, 1, clockUs);
+ChannelBank channels;
+
+void setup() { scheduler.begin(millis()); }
+void loop() { scheduler.run(millis(), channels); }
+
+*/
@@ -0,0 +1,159 @@
+#ifndef SENSOR_FAKES_H
+#define SENSOR_FAKES_H
+
+#include "sensor_driver.h"
+#include <MQ7Cycle.h>
+
+// === Driver sensor palsu untuk host ===
+// Meniru bentuk driver asli (sensor_drivers.h) tanpa hardware: periode,
+// warm-up dan channel sama, biaya poll disimulasikan dengan memajukan jam us
+// palsu, konversi dua tahap (DS18B20/BME280) lewat convMs, dan kegagalan
+// baca bisa disuntikkan tiap N pembacaan. FakeMQ7Driver menjalankan state
+// machine heater MQ7Cycle.h yang sama dengan library asli.
+
+// Jam us palsu bersama: dipakai scheduler sebagai clock dan dimajukan driver
+inline uint32_t& fakeClockUs()
+{
+  static uint32_t us = 0;
+  return us;
+}
+
+inline uint32_t fakeMicros() { return fakeClockUs(); }
+
+class FakeSensorDriver : public SensorDriver {
+  private:
+    uint32_t costUs;      // biaya tiap poll (tahap ambil hasil jika dua tahap)
+    uint32_t startCostUs; // biaya tahap mulai konversi
+    uint32_t convMs;      // 0 = satu tahap
+    float value;
+    float step;
+    uint32_t failEvery;   // 0 = tidak pernah gagal
+    bool present;
+    bool converting;
+    uint32_t cycleNext;
+    uint32_t reads;
+    uint32_t failures;
+    uint32_t beganMs;
+    uint32_t firstPollMs;
+    bool polled;
+
+  protected:
+    void markPolled(uint32_t nowMs) {
+      if (polled) return;
+      polled = true;
+      firstPollMs = nowMs;
+    }
+
+  public:
+    FakeSensorDriver(const char* driverName, uint32_t period, uint32_t warmup, uint8_t first, uint8_t count,
+                     uint32_t cost, uint32_t conversionMs = 0, uint32_t startCost = 0)
+      : SensorDriver(driverName, period, warmup, first, count),
+        costUs(cost), startCostUs(startCost), convMs(conversionMs), value(0), step(0), failEvery(0),
+        present(true), converting(false), cycleNext(0), reads(0), failures(0),
+        beganMs(0), firstPollMs(0), polled(false) {}
+
+    // Nilai channel ke-i = base + i, bertambah step setiap pembacaan
+    void setValue(float base, float increment) {
+      value = base;
+      step = increment;
+    }
+    void setFailEvery(uint32_t n) { failEvery = n; }
+    void setPresent(bool p) { present = p; }
+
+    bool begin(uint32_t nowMs) {
+      beganMs = nowMs;
+      polled = false;
+      converting = false;
+      return present;
+    }
+
+    bool poll(uint32_t nowMs, ChannelBank& bank, uint32_t& nextMs) {
+      markPolled(nowMs);
+      if (convMs && !converting) {
+        fakeClockUs() += startCostUs;
+        converting = true;
+        cycleNext = nextMs;
+        nextMs = nowMs + convMs;
+        return false;
+      }
+      fakeClockUs() += costUs;
+      if (convMs) {
+        converting = false;
+        nextMs = cycleNext;
+      }
+      if (failEvery && ++reads % failEvery == 0) {
+        failures++;
+        return false; // channel tetap nilai terakhir
+      }
+      for (int i = 0; i < channelCount; i++) bank.set(firstChannel + i, sample_t(value + i), nowMs);
+      value += step;
+      return true;
+    }
+
+    // Pembacaan yang seharusnya terjadi dalam elapsedMs sejak begin()
+    virtual uint32_t expectedReads(uint32_t elapsedMs) {
+      return elapsedMs > warmupMs ? (elapsedMs - warmupMs) / periodMs : 0;
+    }
+
+    uint32_t getFailures() { return failures; }
+    bool wasPolled() { return polled; }
+    // Jarak begin() ke poll pertama, untuk cek warm-up
+    uint32_t firstPollDelayMs() { return firstPollMs - beganMs; }
+};
+
+// === MQ7 palsu: heater cycle sungguhan, satu nilai per siklus ===
+// Setiap poll hanya memajukan mq7HeaterCycle (updateUs); pembacaan (costUs)
+// dan nilai baru di channel hanya pada event sampel, seperti MQ7::update().
+class FakeMQ7Driver : public FakeSensorDriver {
+  private:
+    mq7HeaterCycle cycle;
+    uint32_t updateUs;
+
+  public:
+    FakeMQ7Driver(uint32_t period, uint32_t warmup, uint8_t channel, uint32_t update, uint32_t readCost)
+      : FakeSensorDriver("MQ7", period, warmup, channel, 1, readCost), updateUs(update) {}
+
+    bool begin(uint32_t nowMs) {
+      cycle.begin(nowMs);
+      return FakeSensorDriver::begin(nowMs);
+    }
+
+    bool poll(uint32_t nowMs, ChannelBank& bank, uint32_t& nextMs) {
+      markPolled(nowMs);
+      fakeClockUs() += updateUs;
+      if (!(cycle.update(nowMs) & MQ7_EVENT_SAMPLE)) return false;
+      return FakeSensorDriver::poll(nowMs, bank, nextMs);
+    }
+
+    // Satu latch per siklus di awal jendela sampling
+    uint32_t expectedReads(uint32_t elapsedMs) {
+      const uint32_t cycleMs = MQ7_HIGH_MS + MQ7_LOW_MS;
+      const uint32_t latchMs = cycleMs - MQ7_SAMPLE_LEAD_MS;
+      return elapsedMs >= latchMs ? (elapsedMs - latchMs) / cycleMs + 1 : 0;
+    }
+
+    uint32_t getMissed() { return cycle.getMissed(); }
+};
+
+#endif
+
+/*
+*** Example ***
+
+#include "sensor_fakes.h"
+
+FakeSensorDriver gas("MQ2", 250, 20000, CH_GAS, 1, 60);
+FakeMQ7Driver co(500, 0, CH_CO, 8, 60);
+FakeSensorDriver temp("DS18B20", 1000, 0, CH_TEMP0, 4, 24000, 750, 1200);
+SensorDriver* const drivers[] = { &gas, &co, &temp };
+SensorScheduler scheduler(drivers, 3, fakeMicros);
+ChannelBank channels;
+
+int main() {
+  gas.setValue(300, 1);
+  scheduler.begin(0);
+  for (uint32_t ms = 0; ms < 60000; ms++) scheduler.run(ms, channels);
+  printf("MQ2 rata-rata %u us\n", (unsigned)scheduler.avgCostUs(0));
+}
+
+*/
@@ -0,0 +1,64 @@
+#ifndef SLAVE_LOOP_H
+#define SLAVE_LOOP_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "sensor_config.h"
+#include "sensor_driver.h"
+
+// === Satu putaran loop() slave ===
+// Urutan dan jadwal loop() firmware: perintah master, readData(), buzzer,
+// frame RS485 tiap intervalDataRead, lalu tidur sampai driver berikutnya
+// jatuh tempo. main.cpp dan schedsim (host) menjalankan kelas yang sama,
+// hanya langkah-langkahnya yang berbeda, jadi simulasi tidak ikut usang
+// saat urutan loop() berubah. Langkah opsional boleh NULL.
+struct SlaveLoopSteps {
+  void (*pollMaster)();          // opsional
+  void (*readData)();
+  void (*afterRead)();           // opsional (buzzer)
+  void (*sendFrame)();
+  void (*sleepMs)(uint32_t ms);  // tetap melayani master selama tidur
+};
+
+class SlaveLoop {
+  private:
+    SensorScheduler& scheduler;
+    uint32_t (*clockMs)();
+    const SlaveLoopSteps& steps;
+    uint32_t lastFrameSent;
+
+  public:
+    SlaveLoop(SensorScheduler& sched, uint32_t (*nowMs)(), const SlaveLoopSteps& loopSteps)
+      : scheduler(sched), clockMs(nowMs), steps(loopSteps), lastFrameSent(0) {}
+
+    void run() {
+      if (steps.pollMaster) steps.pollMaster();
+      steps.readData();
+      if (steps.afterRead) steps.afterRead();
+      if (clockMs() - lastFrameSent >= intervalDataRead) {
+        lastFrameSent = clockMs();
+        steps.sendFrame();
+      }
+      // Tidur sampai driver berikutnya jatuh tempo
+      steps.sleepMs(scheduler.msUntilNext(clockMs(), SENSOR_IDLE_MAX_MS));
+    }
+};
+
+#endif
+
+/*
+*** Example ***
+
+#include "slave_loop.h"
+
+uint32_t clockMs() { return millis(); }
+void readData() { if (scheduler.run(millis(), channels)) channels.filter(); }
+void sendFrame() { ... }
+void sleepMs(uint32_t ms) { delay(ms); }
+
+const SlaveLoopSteps steps = { NULL, readData, NULL, sendFrame, sleepMs };
+SlaveLoop slaveLoop(scheduler, clockMs, steps);
+
+void loop() { slaveLoop.run(); }
+
+*/
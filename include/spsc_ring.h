@@ -0,0 +1,42 @@
+#ifndef SPSC_RING_H
+#define SPSC_RING_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <atomic>
+
+// === Ring buffer lock-free satu producer, satu consumer ===
+// N harus pangkat 2. Jika penuh, push() gagal (pemanggil yang memutuskan
+// membuang data) sehingga producer tidak pernah menunggu.
+template <typename T, size_t N>
+class SpscRing {
+  private:
+    T items[N];
+    std::atomic<uint32_t> head; // ditulis producer
+    std::atomic<uint32_t> tail; // ditulis consumer
+
+  public:
+    SpscRing() : head(0), tail(0) {}
+
+    bool push(const T& item) {
+      uint32_t h = head.load(std::memory_order_relaxed);
+      if (h - tail.load(std::memory_order_acquire) >= N) return false;
+      items[h & (N - 1)] = item;
+      head.store(h + 1, std::memory_order_release);
+      return true;
+    }
+
+    bool pop(T& item) {
+      uint32_t t = tail.load(std::memory_order_relaxed);
+      if (t == head.load(std::memory_order_acquire)) return false;
+      item = items[t & (N - 1)];
+      tail.store(t + 1, std::memory_order_release);
+      return true;
+    }
+
+    size_t size() {
+      return head.load(std::memory_order_acquire) - tail.load(std::memory_order_acquire);
+    }
+};
+
+#endif
@@ -0,0 +1,208 @@
+#ifndef STREAM_BATCH_H
+#define STREAM_BATCH_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <atomic>
+#include "trace_format.h"
+
+// === Streaming sampel mentah dalam batch biner ===
+// Satu batch (little-endian):
+//   A5 5A | u8 versi | u8 jumlah sampel | u16 seq | u16 panjang payload
+//   | payload: record trace_format berturut-turut | u16 CRC-16/CCITT (header + payload)
+//
+// seq naik satu per batch, termasuk batch yang dibuang, sehingga penerima
+// bisa menghitung batch yang hilang dari lompatan seq.
+//
+// Double buffer: producer (akuisisi) mengisi satu buffer sementara consumer
+// (task TX) mengirim yang lain. Jika batch penuh tapi buffer lain belum selesai
+// dikirim, batch itu dibuang utuh (dropped++) dan producer tidak pernah menunggu.
+
+#define STREAM_SYNC0 0xA5
+#define STREAM_SYNC1 0x5A
+#define STREAM_VERSION 2 // 2: record trace v3 (sentinel NAN BME280)
+#define STREAM_HEADER_SIZE 8
+#define STREAM_CRC_SIZE 2
+#define STREAM_MAX_SAMPLES 32
+#define STREAM_BATCH_MAX_BYTES (STREAM_HEADER_SIZE + STREAM_MAX_SAMPLES * TRACE_RECORD_MAX_SIZE + STREAM_CRC_SIZE)
+
+inline uint16_t streamCrc16(const uint8_t* data, size_t len, uint16_t crc = 0xFFFF)
+{
+  for (size_t i = 0; i < len; i++) {
+    crc ^= (uint16_t)data[i] << 8;
+    for (int b = 0; b < 8; b++) crc = crc & 0x8000 ? (crc << 1) ^ 0x1021 : crc << 1;
+  }
+  return crc;
+}
+
+// Validasi satu batch di awal `in`. Return panjang batch, 0 jika belum lengkap
+// atau rusak. seq/count/payload diisi jika valid.
+inline size_t decodeStreamBatch(const uint8_t* in, size_t len, uint16_t& seq, int& count,
+                                const uint8_t*& payload, size_t& payloadLen)
+{
+  using namespace trace_detail;
+  if (len < STREAM_HEADER_SIZE) return 0;
+  if (in[0] != STREAM_SYNC0 || in[1] != STREAM_SYNC1 || in[2] != STREAM_VERSION) return 0;
+  const uint8_t* p = in + 4;
+  uint16_t s = get16(p);
+  uint16_t plen = get16(p);
+  size_t total = STREAM_HEADER_SIZE + plen + STREAM_CRC_SIZE;
+  if (total > STREAM_BATCH_MAX_BYTES || len < total) return 0;
+  p = in + STREAM_HEADER_SIZE + plen;
+  if (get16(p) != streamCrc16(in, STREAM_HEADER_SIZE + plen)) return 0;
+  seq = s;
+  count = in[3];
+  payload = in + STREAM_HEADER_SIZE;
+  payloadLen = plen;
+  return total;
+}
+
+class StreamBatcher {
+  private:
+    enum BufferState { BUF_FREE, BUF_FILLING, BUF_READY, BUF_SENDING };
+
+    struct Buffer {
+      uint8_t data[STREAM_BATCH_MAX_BYTES];
+      size_t len;
+      int count;
+      std::atomic<uint8_t> state;
+    };
+
+    Buffer buffers[2];
+    int filling; // hanya disentuh producer
+    int batchSamples;
+    uint16_t seq;
+    std::atomic<uint32_t> sent;
+    std::atomic<uint32_t> dropped;
+    size_t sendOffset; // hanya disentuh consumer (pump)
+
+    void resetFilling() {
+      buffers[filling].len = STREAM_HEADER_SIZE;
+      buffers[filling].count = 0;
+    }
+
+    void seal(Buffer& b) {
+      using namespace trace_detail;
+      uint8_t* p = b.data;
+      *p++ = STREAM_SYNC0;
+      *p++ = STREAM_SYNC1;
+      *p++ = STREAM_VERSION;
+      *p++ = (uint8_t)b.count;
+      put16(p, seq++);
+      put16(p, (uint16_t)(b.len - STREAM_HEADER_SIZE));
+      p = b.data + b.len;
+      put16(p, streamCrc16(b.data, b.len));
+      b.len += STREAM_CRC_SIZE;
+    }
+
+  public:
+    StreamBatcher() : filling(0), batchSamples(16), seq(0), sent(0), dropped(0), sendOffset(0) {
+      buffers[0].state = BUF_FILLING;
+      buffers[1].state = BUF_FREE;
+      resetFilling();
+    }
+
+    // Jumlah sampel per batch (1..STREAM_MAX_SAMPLES). Panggil sebelum streaming.
+    void begin(int samplesPerBatch) {
+      if (samplesPerBatch < 1) samplesPerBatch = 1;
+      if (samplesPerBatch > STREAM_MAX_SAMPLES) samplesPerBatch = STREAM_MAX_SAMPLES;
+      batchSamples = samplesPerBatch;
+      filling = 0;
+      seq = 0;
+      sent = 0;
+      dropped = 0;
+      sendOffset = 0;
+      buffers[0].state = BUF_FILLING;
+      buffers[1].state = BUF_FREE;
+      resetFilling();
+    }
+
+    // === Producer ===
+    // Tambah satu sampel. Return false jika batch yang baru penuh terpaksa dibuang.
+    bool push(const TraceSample& s) {
+      Buffer& b = buffers[filling];
+      b.len += encodeTraceSample(s, b.data + b.len);
+      if (++b.count < batchSamples) return true;
+
+      seal(b);
+      Buffer& other = buffers[filling ^ 1];
+      if (other.state.load(std::memory_order_acquire) != BUF_FREE) {
+        dropped.fetch_add(1, std::memory_order_relaxed);
+        resetFilling(); // link macet: buang batch utuh, isi ulang buffer yang sama
+        return false;
+      }
+      other.state.store(BUF_FILLING, std::memory_order_relaxed);
+      b.state.store(BUF_READY, std::memory_order_release);
+      filling ^= 1;
+      resetFilling();
+      return true;
+    }
+
+    // === Consumer ===
+    // Ambil batch siap kirim, NULL jika tidak ada.
+    const uint8_t* acquire(size_t& len) {
+      for (int i = 0; i < 2; i++) {
+        uint8_t expected = BUF_READY;
+        if (buffers[i].state.compare_exchange_strong(expected, BUF_SENDING, std::memory_order_acquire)) {
+          len = buffers[i].len;
+          return buffers[i].data;
+        }
+      }
+      return NULL;
+    }
+
+    // Kembalikan buffer dari acquire(). delivered=false jika batch tidak terkirim.
+    void release(const uint8_t* data, bool delivered = true) {
+      for (int i = 0; i < 2; i++) {
+        if (buffers[i].data != data) continue;
+        if (delivered) sent.fetch_add(1, std::memory_order_relaxed);
+        else dropped.fetch_add(1, std::memory_order_relaxed);
+        buffers[i].state.store(BUF_FREE, std::memory_order_release);
+      }
+    }
+
+    // Kirim ke sink non-blocking: sink.write() boleh menerima sebagian (atau 0
+    // saat link macet); sisanya dilanjutkan di pump() berikutnya.
+    template <typename Sink>
+    void pump(Sink& sink) {
+      for (int i = 0; i < 2; i++) {
+        Buffer& b = buffers[i];
+        uint8_t st = b.state.load(std::memory_order_acquire);
+        if (st == BUF_READY && sendOffset == 0) {
+          b.state.store(BUF_SENDING, std::memory_order_relaxed);
+          st = BUF_SENDING;
+        }
+        if (st != BUF_SENDING) continue;
+        sendOffset += sink.write(b.data + sendOffset, b.len - sendOffset);
+        if (sendOffset < b.len) return;
+        sendOffset = 0;
+        release(b.data);
+      }
+    }
+
+    uint32_t getSent() { return sent.load(std::memory_order_relaxed); }
+    uint32_t getDropped() { return dropped.load(std::memory_order_relaxed); }
+    uint16_t getSequence() { return seq; }
+    int getBatchSamples() { return batchSamples; }
+};
+
+#endif
+
+/*
+*** Example ***
+
+#include "stream_batch.h"
+
+StreamBatcher batcher;
+
+void setup() {
+  batcher.begin(16);
+}
+
+void loop() {
+  TraceSample s = ...;   // sampel mentah
+  batcher.push(s);       // tidak pernah blocking
+  batcher.pump(Serial);  // atau task terpisah: acquire() -> write -> release()
+}
+
+*/
@@ -0,0 +1,149 @@
+#ifndef TRACE_FORMAT_H
+#define TRACE_FORMAT_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <math.h>
+
+// === Format rekaman trace sensor mentah ===
+// Header file : "FTRC" + versi (1 byte) + 3 byte cadangan
+// Tiap record (little-endian):
+//   u32 timeMs | u16 mq2 | i16 mq7 | u8 n | i16 temp[n] (0.01 °C, -32768 = NAN)
+//   | u16 humidity (0.01 %, 0xFFFF = NAN) | u32 pressure (Pa, 0xFFFFFFFF = NAN)
+//   | i16 ambient BME280 (0.01 °C, -32768 = NAN, hanya versi >= 2)
+// Versi < 3 menulis kelembapan/tekanan NAN sebagai 0; decoder membaca 0 di
+// versi lama sebagai NAN (0 % / 0 Pa tidak mungkin dari BME280).
+
+#define TRACE_MAGIC "FTRC"
+#define TRACE_VERSION 3
+#define TRACE_NAN_I16 -32768
+#define TRACE_NAN_HUMIDITY 0xFFFF
+#define TRACE_NAN_PRESSURE 0xFFFFFFFFUL
+#define TRACE_HEADER_SIZE 8
+#define TRACE_MAX_TEMPS 8
+#define TRACE_RECORD_MAX_SIZE (4 + 2 + 2 + 1 + 2 * TRACE_MAX_TEMPS + 2 + 4 + 2)
+
+struct TraceSample {
+  uint32_t timeMs;
+  int mq2;
+  int mq7;
+  int tempCount;
+  float temps[TRACE_MAX_TEMPS];
+  float humidity;
+  float pressure; // hPa
+  float ambient;  // suhu BME280, NAN pada trace versi 1
+};
+
+namespace trace_detail {
+  inline void put16(uint8_t*& p, uint16_t v) { *p++ = v & 0xFF; *p++ = v >> 8; }
+  inline void put32(uint8_t*& p, uint32_t v) { put16(p, v & 0xFFFF); put16(p, v >> 16); }
+  inline uint16_t get16(const uint8_t*& p) { uint16_t v = p[0] | (p[1] << 8); p += 2; return v; }
+  inline uint32_t get32(const uint8_t*& p) { uint32_t lo = get16(p); return lo | ((uint32_t)get16(p) << 16); }
+
+  inline int32_t scaled(float v, float scale, int32_t lo, int32_t hi) {
+    float s = roundf(v * scale);
+    if (!(s >= lo)) return lo; // NaN ikut ke batas bawah
+    if (s > hi) return hi;
+    return (int32_t)s;
+  }
+
+  // Seperti scaled(), tapi NAN ditulis sebagai sentinel di luar rentang valid
+  inline uint32_t scaledOrNan(float v, float scale, int32_t lo, int32_t hi, uint32_t nanCode) {
+    return v == v ? (uint32_t)scaled(v, scale, lo, hi) : nanCode;
+  }
+}
+
+inline size_t encodeTraceHeader(uint8_t* out)
+{
+  for (int i = 0; i < 4; i++) out[i] = TRACE_MAGIC[i];
+  out[4] = TRACE_VERSION;
+  out[5] = out[6] = out[7] = 0;
+  return TRACE_HEADER_SIZE;
+}
+
+// Return versi trace, 0 jika bukan file trace yang dikenal
+inline int decodeTraceHeader(const uint8_t* in, size_t len)
+{
+  if (len < TRACE_HEADER_SIZE) return 0;
+  for (int i = 0; i < 4; i++) if (in[i] != (uint8_t)TRACE_MAGIC[i]) return 0;
+  if (in[4] < 1 || in[4] > TRACE_VERSION) return 0;
+  return in[4];
+}
+
+// Encode satu sampel. `out` minimal TRACE_RECORD_MAX_SIZE byte.
+inline size_t encodeTraceSample(const TraceSample& s, uint8_t* out)
+{
+  using namespace trace_detail;
+  uint8_t* p = out;
+  int n = s.tempCount < TRACE_MAX_TEMPS ? s.tempCount : TRACE_MAX_TEMPS;
+  put32(p, s.timeMs);
+  put16(p, (uint16_t)scaled(s.mq2, 1, 0, 0xFFFF));
+  put16(p, (uint16_t)scaled(s.mq7, 1, -32768, 32767));
+  *p++ = (uint8_t)n;
+  for (int i = 0; i < n; i++) put16(p, (uint16_t)scaledOrNan(s.temps[i], 100, -32767, 32767, (uint16_t)TRACE_NAN_I16));
+  put16(p, (uint16_t)scaledOrNan(s.humidity, 100, 0, 0xFFFE, TRACE_NAN_HUMIDITY));
+  put32(p, scaledOrNan(s.pressure, 100, 0, 0x7FFFFFFF, TRACE_NAN_PRESSURE));
+  put16(p, (uint16_t)scaledOrNan(s.ambient, 100, -32767, 32767, (uint16_t)TRACE_NAN_I16));
+  return p - out;
+}
+
+// Decode satu record. Return jumlah byte terpakai, 0 jika data belum lengkap/rusak.
+inline size_t decodeTraceSample(const uint8_t* in, size_t len, TraceSample& s, int version = TRACE_VERSION)
+{
+  using namespace trace_detail;
+  size_t tail = version >= 2 ? 8 : 6;
+  if (len < 9) return 0;
+  const uint8_t* p = in;
+  s.timeMs = get32(p);
+  s.mq2 = get16(p);
+  s.mq7 = (int16_t)get16(p);
+  s.tempCount = *p++;
+  if (s.tempCount > TRACE_MAX_TEMPS) return 0;
+  if (len < 9 + 2 * s.tempCount + tail) return 0;
+  for (int i = 0; i < s.tempCount; i++) {
+    int16_t t = (int16_t)get16(p);
+    s.temps[i] = t == TRACE_NAN_I16 ? NAN : t / 100.0f;
+  }
+  uint16_t humidity = get16(p);
+  uint32_t pressure = get32(p);
+  bool missing = version >= 3 ? humidity == TRACE_NAN_HUMIDITY : humidity == 0;
+  s.humidity = missing ? NAN : humidity / 100.0f;
+  missing = version >= 3 ? pressure == TRACE_NAN_PRESSURE : pressure == 0;
+  s.pressure = missing ? NAN : pressure / 100.0f;
+  s.ambient = NAN;
+  if (version >= 2) {
+    int16_t ambient = (int16_t)get16(p);
+    if (ambient != TRACE_NAN_I16) s.ambient = ambient / 100.0f;
+  }
+  return p - in;
+}
+
+// === Perekam trace ke sink apa pun yang punya write(const uint8_t*, size_t) ===
+// (Print/File di ESP32, atau wrapper FILE* di host)
+template <typename Sink>
+class TraceRecorder {
+  private:
+    Sink& sink;
+    uint32_t recordCount;
+    uint32_t byteCount;
+
+  public:
+    TraceRecorder(Sink& s) : sink(s), recordCount(0), byteCount(0) {}
+
+    // Tulis header, panggil sekali di awal file baru
+    void begin() {
+      uint8_t header[TRACE_HEADER_SIZE];
+      byteCount += sink.write(header, encodeTraceHeader(header));
+    }
+
+    void record(const TraceSample& s) {
+      uint8_t buf[TRACE_RECORD_MAX_SIZE];
+      byteCount += sink.write(buf, encodeTraceSample(s, buf));
+      recordCount++;
+    }
+
+    uint32_t getRecordCount() { return recordCount; }
+    uint32_t getByteCount() { return byteCount; }
+};
+
+#endif
@@ -1,5 +1,6 @@
 #include "Arduino.h"
 #include "MQ2.h"
+#include <MQMath.h>
 
 MQ2::MQ2(int pin) {
 	_pin = pin;
@@ -13,13 +14,45 @@ void MQ2::begin(){
 	Serial.println(" kohm");
 }
 
+bool MQ2::calibrateStep() {
+	if (isCalibrated()) return false;
+
+	uint32_t raw = MQReadRaw();
+	if (raw == 0) return false;
+
+	_calSum += MQResistanceCalculation(raw);
+	if (++_calCount < CALIBARAION_SAMPLE_TIMES) return false;
+
+	Ro = _calSum / ((float) CALIBARAION_SAMPLE_TIMES) / RO_CLEAN_AIR_FACTOR;
+	return true;
+}
+
+bool MQ2::isCalibrated() {
+	return Ro >= 0.0;
+}
+
+float MQ2::getRo() {
+	return Ro;
+}
+
 void MQ2::close(){
 	Ro = -1.0;
+	_calSum = 0.0;
+	_calCount = 0;
 	values[0] = 0.0;
 	values[1] = 0.0;
 	values[2] = 0.0;
 }
 
+void MQ2::setCalibration(const adcCalibration* cal) {
+	_cal = cal;
+}
+
+void MQ2::setReader(uint16_t (*reader)(), uint8_t bits) {
+	_reader = reader;
+	_readerBits = reader ? bits : MQ_ADC_BITS;
+}
+
 bool MQ2::checkCalibration() {
 	if (Ro < 0.0) {
 		Serial.println("Device not calibrated, call MQ2::begin before reading any value.");
@@ -81,9 +114,12 @@ float MQ2::readSmoke(){
         return (values[2] = MQGetPercentage(SmokeCurve));
 }
 
-float MQ2::MQResistanceCalculation(int raw_adc) {
-	float flt_adc = (float) raw_adc;
-	return RL_VALUE * (1023.0 - flt_adc) / flt_adc;
+uint32_t MQ2::MQReadRaw() {
+	return _reader ? _reader() : analogRead(_pin);
+}
+
+float MQ2::MQResistanceCalculation(uint32_t raw_adc) {
+	return mqResistanceRaw(raw_adc, _readerBits, _cal, RL_VALUE);
 }
 
 float MQ2::MQCalibration() {
@@ -91,7 +127,7 @@ float MQ2::MQCalibration() {
 
 	// take multiple samples
 	for (int i = 0; i < CALIBARAION_SAMPLE_TIMES; i++) {
-		val += MQResistanceCalculation(analogRead(_pin));
+		val += MQResistanceCalculation(MQReadRaw());
 		delay(CALIBRATION_SAMPLE_INTERVAL);
 	}
 
@@ -108,7 +144,7 @@ float MQ2::MQRead() {
 	float rs = 0.0;
 
 	for (int i = 0; i < READ_SAMPLE_TIMES; i++) {
-		rs += MQResistanceCalculation(analogRead(_pin));
+		rs += MQResistanceCalculation(MQReadRaw());
 		delay(READ_SAMPLE_INTERVAL);
 	}
 
@@ -116,6 +152,5 @@ float MQ2::MQRead() {
 }
 
 float MQ2::MQGetPercentage(float *pcurve) {
-	float rs_ro_ratio = MQRead() / Ro;
-	return pow(10.0, ((log(rs_ro_ratio) - pcurve[1]) / pcurve[2]) + pcurve[0]);
+	return mqPercentage(MQRead() / Ro, pcurve);
 }
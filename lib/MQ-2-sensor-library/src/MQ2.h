@@ -7,6 +7,8 @@
  # include "WProgram.h"
 # endif
 
+# include <AdcCalibration.h>
+
 // define the load resistance on the board, in kilo ohms
 # define RL_VALUE 5.0
 // given constant
@@ -38,6 +40,19 @@ class MQ2 {
 		 */
 		void begin();
 
+		/*
+		 * Non-blocking alternative to `begin()` for callers that poll the
+		 * sensor, e.g. a scheduler once the heater has warmed up. Each call
+		 * takes one reading from the configured reader (see `setReader()`);
+		 * a zero reading, such as an oversampled channel without output yet,
+		 * is skipped. Ro is set after `CALIBARAION_SAMPLE_TIMES` readings and
+		 * the call that completes it returns true. `close()` starts over.
+		 */
+		bool calibrateStep();
+
+		bool isCalibrated();
+		float getRo();
+
 		/*
 		 * Stops the sensor, calibration and any read data is deleted.
 		 *
@@ -46,6 +61,21 @@ class MQ2 {
 		 */
 		void close();
 
+		/*
+		 * Uses a raw-code to millivolt table (shared with other MQ sensors)
+		 * instead of assuming a linear 0..MQ_ADC_MAX scale. Call before `begin()`
+		 * so Ro is calibrated with the same conversion. NULL restores linear.
+		 */
+		void setCalibration(const adcCalibration* cal);
+
+		/*
+		 * Alternative raw source, e.g. the oversampled DMA ADC, so nothing
+		 * calls `analogRead()` on ADC1 while continuous mode owns it.
+		 * `bits` is the reader resolution (MQ_ADC_WIDE_BITS when oversampling);
+		 * the full width is kept through calibration. NULL restores analogRead().
+		 */
+		void setReader(uint16_t (*reader)(), uint8_t bits = MQ_ADC_BITS);
+
 		/*
 		 * Reads the LPG, CO and smoke data from the sensor and returns and
 		 * array with the values in this order.
@@ -70,18 +100,24 @@ class MQ2 {
 
 	private:
 		int _pin;
+		const adcCalibration* _cal = NULL;
+		uint16_t (*_reader)() = NULL;
+		uint8_t _readerBits = MQ_ADC_BITS;
 
 		float LPGCurve[3] = {2.3, 0.21, -0.47}; 
 		float COCurve[3] = {2.3, 0.72, -0.34};   
 		float SmokeCurve[3] = {2.3, 0.53, -0.44};                                                       
 		float Ro = -1.0;
+		float _calSum = 0.0;
+		int _calCount = 0;
 
 		float values[3];  // array with the measured values in the order: lpg, CO and smoke
 		
 		float MQRead();
 		float MQGetPercentage(float *pcurve);
 		float MQCalibration();
-		float MQResistanceCalculation(int raw_adc);
+		float MQResistanceCalculation(uint32_t raw_adc);
+		uint32_t MQReadRaw();
 		bool checkCalibration();
 
 		int lastReadTime = 0;
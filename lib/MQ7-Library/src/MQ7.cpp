@@ -0,0 +1,75 @@
+#include "MQ7.h"
+#include <MQMath.h>
+
+MQ7::MQ7(int pin, int heaterPin, float heaterVoltage)
+    : _pin(pin), _heaterPin(heaterPin), _cal(NULL), _reader(NULL), _readerBits(MQ_ADC_BITS),
+      _ro(-1.0), _rs(0.0), _ppm(0.0), _timestamp(0), _latches(0), _hasReading(false)
+{
+    // Daya heater ~ V^2: duty untuk setara 1.4 V DC = (1.4 / Vheater)^2
+    float ratio = MQ7_LOW_VOLTAGE / heaterVoltage;
+    if (ratio > 1.0) ratio = 1.0;
+    _dutyLow = (uint32_t)(ratio * ratio * ((1 << MQ7_LEDC_BITS) - 1) + 0.5);
+}
+
+void MQ7::begin(uint32_t now)
+{
+    ledcSetup(MQ7_LEDC_CHANNEL, MQ7_LEDC_FREQ, MQ7_LEDC_BITS);
+    ledcAttachPin(_heaterPin, MQ7_LEDC_CHANNEL);
+    _cycle.begin(now);
+    applyHeater();
+}
+
+void MQ7::setCalibration(const adcCalibration* cal)
+{
+    _cal = cal;
+}
+
+void MQ7::setReader(uint16_t (*reader)(), uint8_t bits)
+{
+    _reader = reader;
+    _readerBits = reader ? bits : MQ_ADC_BITS;
+}
+
+void MQ7::applyHeater()
+{
+    uint32_t duty = _cycle.getPhase() == MQ7_PHASE_HIGH ? (1 << MQ7_LEDC_BITS) - 1 : _dutyLow;
+    ledcWrite(MQ7_LEDC_CHANNEL, duty);
+}
+
+float MQ7::readRs()
+{
+    uint32_t sum = 0;
+    for (int i = 0; i < MQ7_READ_SAMPLES; i++) {
+        sum += _reader ? _reader() : analogRead(_pin);
+    }
+    uint32_t raw = (sum + MQ7_READ_SAMPLES / 2) / MQ7_READ_SAMPLES;
+    return mqResistanceRaw(raw, _readerBits, _cal, MQ7_RL_VALUE);
+}
+
+bool MQ7::update(uint32_t now)
+{
+    uint8_t events = _cycle.update(now);
+    if (events & MQ7_EVENT_PHASE) applyHeater();
+    if (!(events & MQ7_EVENT_SAMPLE)) return false;
+
+    _rs = readRs();
+    if (_ro < 0.0) {
+        // Siklus pertama setelah boot dianggap udara bersih
+        _ro = _rs / MQ7_RO_CLEAN_AIR_FACTOR;
+    }
+    _ppm = mq7CoPpm(_rs / _ro);
+    _timestamp = now;
+    _latches++;
+    _hasReading = true;
+    return true;
+}
+
+float MQ7::getPPM()
+{
+    return _hasReading ? _ppm : 0.0;
+}
+
+bool MQ7::isFresh(uint32_t now, uint32_t maxAgeMs)
+{
+    return _hasReading && now - _timestamp <= maxAgeMs;
+}
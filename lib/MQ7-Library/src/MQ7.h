@@ -0,0 +1,145 @@
+#ifndef MQ7_h
+#define MQ7_h
+
+#include <Arduino.h>
+#include <AdcCalibration.h>
+#include "MQ7Cycle.h"
+#include "MQ7Curve.h"
+
+// Load resistor modul MQ-7 (kilo ohm)
+#define MQ7_RL_VALUE 10.0
+// Rs/Ro di udara bersih (datasheet)
+#define MQ7_RO_CLEAN_AIR_FACTOR 27.5
+// Tegangan heater fase low (datasheet)
+#define MQ7_LOW_VOLTAGE 1.4
+
+#define MQ7_LEDC_CHANNEL 0
+#define MQ7_LEDC_FREQ 1000
+#define MQ7_LEDC_BITS 8
+
+// Jumlah analogRead berturut-turut yang dirata-rata saat latch (tanpa delay)
+#define MQ7_READ_SAMPLES 8
+
+/**
+ * @brief Driver MQ-7 dengan siklus heater PWM tanpa blocking.
+ *
+ * update() dipanggil dari loop(); driver mengatur duty heater sesuai fase dan
+ * me-latch satu pembacaan CO di akhir tiap fase low (setiap 150 detik).
+ * Pembacaan pertama setelah boot dipakai untuk kalibrasi Ro (udara bersih).
+ */
+class MQ7
+{
+    public:
+         /**
+         * @brief Konstruktor MQ7.
+         *
+         * @param pin Pin analog output sensor.
+         * @param heaterPin Pin PWM yang men-drive MOSFET heater.
+         * @param heaterVoltage Tegangan suplai heater (V) saat duty 100%.
+         */
+        MQ7(int pin, int heaterPin, float heaterVoltage = 5.0);
+
+         /**
+         * @brief Menyiapkan PWM heater dan memulai siklus dari fase high.
+         *
+         * @param now Waktu sekarang (ms).
+         */
+        void begin(uint32_t now);
+
+         /**
+         * @brief Memakai tabel kalibrasi ADC yang sama dengan MQ2.
+         *
+         * @param cal Tabel raw -> mV, NULL untuk skala linear.
+         */
+        void setCalibration(const adcCalibration* cal);
+
+         /**
+         * @brief Sumber pembacaan raw alternatif, mis. dari ADC DMA.
+         *
+         * @param reader Fungsi pembaca, NULL untuk analogRead().
+         * @param bits Resolusi hasil reader (MQ_ADC_WIDE_BITS untuk oversampling).
+         */
+        void setReader(uint16_t (*reader)(), uint8_t bits = MQ_ADC_BITS);
+
+         /**
+         * @brief Memajukan siklus heater; tidak pernah blocking.
+         *
+         * @param now Waktu sekarang (ms).
+         * @return bool true jika pembacaan baru di-latch.
+         */
+        bool update(uint32_t now);
+
+         /**
+         * @brief Konsentrasi CO terakhir yang di-latch.
+         *
+         * @return float ppm, 0 sebelum ada pembacaan terkalibrasi.
+         */
+        float getPPM();
+
+        float getRs() { return _rs; }
+        float getRo() { return _ro; }
+
+         /**
+         * @brief Waktu (ms) saat pembacaan terakhir di-latch.
+         */
+        uint32_t getTimestamp() { return _timestamp; }
+
+         /**
+         * @brief Jumlah pembacaan yang sudah di-latch sejak boot.
+         *
+         * Latch pertama sekaligus kalibrasi Ro; pemanggil yang melaporkan
+         * (library tidak menulis ke Serial).
+         */
+        uint32_t getLatchCount() { return _latches; }
+
+         /**
+         * @brief Apakah pembacaan terakhir masih dari siklus ini/sebelumnya.
+         *
+         * @param now Waktu sekarang (ms).
+         * @param maxAgeMs Umur maksimum, default satu siklus penuh.
+         */
+        bool isFresh(uint32_t now, uint32_t maxAgeMs = MQ7_HIGH_MS + MQ7_LOW_MS);
+
+        const mq7HeaterCycle& getCycle() { return _cycle; }
+
+    private:
+        int _pin;
+        int _heaterPin;
+        uint32_t _dutyLow;
+        const adcCalibration* _cal;
+        uint16_t (*_reader)();
+        uint8_t _readerBits;
+        mq7HeaterCycle _cycle;
+
+        float _ro;
+        float _rs;
+        float _ppm;
+        uint32_t _timestamp;
+        uint32_t _latches;
+        bool _hasReading;
+
+        void applyHeater();
+        float readRs();
+};
+
+#endif
+
+/*
+*** Example ***
+
+#include <MQ7.h>
+
+MQ7 mq7(35, 26, 5.0);
+
+void setup() {
+  Serial.begin(115200);
+  mq7.begin(millis());
+}
+
+void loop() {
+  if (mq7.update(millis())) {
+    Serial.printf("CO %.1f ppm @ %lu ms\n", mq7.getPPM(), mq7.getTimestamp());
+  }
+}
+
+*/
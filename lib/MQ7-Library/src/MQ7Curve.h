@@ -0,0 +1,16 @@
+#ifndef MQ7Curve_h
+#define MQ7Curve_h
+
+#include <MQMath.h>
+
+// Kurva CO MQ-7 dari datasheet dalam log10: {log10 ppm, log10 Rs/Ro, slope}.
+// 100 ppm pada Rs/Ro = 1, rasio turun 0.7 dekade per dekade ppm.
+static const float MQ7_CO_CURVE[3] = {2.0f, 0.0f, -0.70f};
+
+// ppm CO dari Rs/Ro; tanpa Arduino sehingga bisa diuji di host
+inline float mq7CoPpm(float rsRoRatio)
+{
+    return mqPercentageLog10(rsRoRatio, MQ7_CO_CURVE);
+}
+
+#endif
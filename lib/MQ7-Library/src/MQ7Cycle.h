@@ -0,0 +1,111 @@
+#ifndef MQ7Cycle_h
+#define MQ7Cycle_h
+
+#include <stdint.h>
+
+// Siklus heater dari datasheet MQ-7
+#define MQ7_HIGH_MS 60000UL      // 5.0 V: membersihkan permukaan sensor
+#define MQ7_LOW_MS 90000UL       // 1.4 V: fase pengukuran CO
+#define MQ7_SAMPLE_LEAD_MS 2000UL // jendela sampling sebelum fase low berakhir
+
+enum MQ7Phase {
+    MQ7_PHASE_HIGH = 0,
+    MQ7_PHASE_LOW
+};
+
+// Event hasil update(), bisa digabung (bitmask)
+#define MQ7_EVENT_NONE 0
+#define MQ7_EVENT_PHASE 0x01  // fase berganti, terapkan duty heater baru
+#define MQ7_EVENT_SAMPLE 0x02 // baca ADC sekarang (akhir fase low)
+#define MQ7_EVENT_MISSED 0x04 // fase low berakhir tanpa sempat disampling
+
+/**
+ * @brief State machine siklus heater MQ-7 tanpa blocking dan tanpa Arduino.
+ *
+ * Waktu disuntikkan lewat parameter now (ms, boleh wrap 32-bit), sehingga bisa
+ * dijalankan di host dengan clock simulasi. Sampling hanya diminta sekali per
+ * siklus, di jendela MQ7_SAMPLE_LEAD_MS terakhir fase low; jika update() terlambat
+ * dipanggil hingga fase low terlewati, siklus itu dicatat sebagai missed dan
+ * tidak ada pembacaan basi yang di-latch.
+ */
+class mq7HeaterCycle
+{
+    public:
+        mq7HeaterCycle(uint32_t highMs = MQ7_HIGH_MS, uint32_t lowMs = MQ7_LOW_MS, uint32_t leadMs = MQ7_SAMPLE_LEAD_MS)
+            : _highMs(highMs), _lowMs(lowMs), _leadMs(leadMs),
+              _phase(MQ7_PHASE_HIGH), _phaseStart(0), _sampled(false), _cycles(0), _missed(0) {}
+
+         /**
+         * @brief Memulai siklus dari fase high.
+         *
+         * @param now Waktu sekarang (ms).
+         */
+        void begin(uint32_t now)
+        {
+            _phase = MQ7_PHASE_HIGH;
+            _phaseStart = now;
+            _sampled = false;
+            _cycles = 0;
+            _missed = 0;
+        }
+
+         /**
+         * @brief Memajukan state machine.
+         *
+         * @param now Waktu sekarang (ms).
+         * @return uint8_t Gabungan MQ7_EVENT_*.
+         */
+        uint8_t update(uint32_t now)
+        {
+            uint8_t events = MQ7_EVENT_NONE;
+
+            // Maju fase demi fase agar panggilan yang sangat terlambat tetap konsisten
+            while (now - _phaseStart >= phaseLength()) {
+                if (_phase == MQ7_PHASE_LOW) {
+                    if (!_sampled) {
+                        _missed++;
+                        events |= MQ7_EVENT_MISSED;
+                    }
+                    _cycles++;
+                }
+                _phaseStart += phaseLength();
+                _phase = _phase == MQ7_PHASE_HIGH ? MQ7_PHASE_LOW : MQ7_PHASE_HIGH;
+                _sampled = false;
+                events |= MQ7_EVENT_PHASE;
+            }
+
+            if (_phase == MQ7_PHASE_LOW && !_sampled && now - _phaseStart >= _lowMs - _leadMs) {
+                _sampled = true;
+                events |= MQ7_EVENT_SAMPLE;
+            }
+            return events;
+        }
+
+        MQ7Phase getPhase() const { return _phase; }
+
+         /**
+         * @brief Sisa waktu fase sekarang (ms), berguna untuk menjadwalkan tidur.
+         */
+        uint32_t remaining(uint32_t now) const
+        {
+            uint32_t elapsed = now - _phaseStart;
+            return elapsed >= phaseLength() ? 0 : phaseLength() - elapsed;
+        }
+
+        uint32_t getCycles() const { return _cycles; }
+        uint32_t getMissed() const { return _missed; }
+
+    private:
+        uint32_t _highMs;
+        uint32_t _lowMs;
+        uint32_t _leadMs;
+        MQ7Phase _phase;
+        uint32_t _phaseStart;
+        bool _sampled;
+        uint32_t _cycles;
+        uint32_t _missed;
+
+        uint32_t phaseLength() const { return _phase == MQ7_PHASE_HIGH ? _highMs : _lowMs; }
+};
+
+#endif
@@ -0,0 +1,189 @@
+#ifndef AdcCalibration_h
+#define AdcCalibration_h
+
+#include <stdint.h>
+
+#if defined(ESP32) && defined(ARDUINO)
+#include <esp_adc_cal.h>
+#endif
+
+// Resolusi analogRead() yang dipakai semua driver MQ (override lewat build flag)
+#ifndef MQ_ADC_BITS
+#define MQ_ADC_BITS 10
+#endif
+#define MQ_ADC_MAX ((1 << MQ_ADC_BITS) - 1)
+
+// Resolusi efektif pembacaan hasil oversampling (CIC 16-bit, lihat adc_engine.h)
+#define MQ_ADC_WIDE_BITS 16
+#define MQ_ADC_WIDE_MAX ((1UL << MQ_ADC_WIDE_BITS) - 1)
+
+// Tegangan nominal kode skala penuh pada atenuasi 11 dB tanpa kalibrasi,
+// sekaligus tegangan rangkaian pembagi MQ yang dipakai mqResistance()
+#ifndef MQ_ADC_FULL_SCALE_MV
+#define MQ_ADC_FULL_SCALE_MV 3300
+#endif
+
+#define ADC_CAL_MAX_POINTS 8
+#define ADC_CAL_MAGIC 0x41444331 // "ADC1"
+
+/**
+ * @brief Titik kurva kalibrasi per-device: kode ADC mentah -> millivolt terukur.
+ */
+struct AdcCurvePoint {
+    uint16_t raw;
+    uint16_t mv;
+};
+
+/**
+ * @brief Kurva kalibrasi yang disimpan di EEPROM (hasil pengukuran di bench).
+ */
+struct AdcCalCurve {
+    uint32_t magic;
+    uint8_t count;
+    AdcCurvePoint points[ADC_CAL_MAX_POINTS]; // urut naik berdasarkan raw
+};
+
+/**
+ * @brief Sumber data tabel kalibrasi yang sedang aktif.
+ */
+enum AdcCalSource {
+    ADC_CAL_LINEAR = 0, // asumsi linear 0..MQ_ADC_MAX -> 0..MQ_ADC_FULL_SCALE_MV
+    ADC_CAL_EFUSE,      // Vref / two-point dari eFuse (esp_adc_cal)
+    ADC_CAL_CURVE       // kurva per-device dari EEPROM
+};
+
+/**
+ * @brief Tabel lookup kode ADC -> millivolt untuk mengoreksi nonlinearitas ADC ESP32.
+ *
+ * Tabel dibangun sekali saat boot; di hot path konversi hanya satu akses array.
+ * Tanpa kalibrasi tabelnya linear dan hasil mqResistance identik dengan rumus lama.
+ */
+class adcCalibration
+{
+    public:
+        adcCalibration() : _source(ADC_CAL_LINEAR) { buildLinear(); }
+
+         /**
+         * @brief Membangun tabel linear (perilaku lama tanpa koreksi).
+         */
+        void buildLinear()
+        {
+            for (uint32_t raw = 0; raw <= MQ_ADC_MAX; raw++) {
+                _table[raw] = (uint16_t)((raw * MQ_ADC_FULL_SCALE_MV + MQ_ADC_MAX / 2) / MQ_ADC_MAX);
+            }
+            _source = ADC_CAL_LINEAR;
+        }
+
+         /**
+         * @brief Membangun tabel dari kurva per-device (interpolasi linear antar titik,
+         * ekstrapolasi dari segmen ujung, dijepit 0..65535 mV).
+         *
+         * @param curve Kurva dari EEPROM.
+         * @return bool false jika kurva tidak valid (tabel tidak diubah).
+         */
+        bool buildFromCurve(const AdcCalCurve& curve)
+        {
+            if (curve.magic != ADC_CAL_MAGIC || curve.count < 2 || curve.count > ADC_CAL_MAX_POINTS) return false;
+            for (int i = 1; i < curve.count; i++) {
+                if (curve.points[i].raw <= curve.points[i - 1].raw) return false;
+            }
+
+            int seg = 0;
+            for (uint32_t raw = 0; raw <= MQ_ADC_MAX; raw++) {
+                while (seg < curve.count - 2 && raw > curve.points[seg + 1].raw) seg++;
+                const AdcCurvePoint& a = curve.points[seg];
+                const AdcCurvePoint& b = curve.points[seg + 1];
+                int32_t mv = a.mv + ((int32_t)raw - a.raw) * ((int32_t)b.mv - a.mv) / ((int32_t)b.raw - a.raw);
+                _table[raw] = mv < 0 ? 0 : (mv > 65535 ? 65535 : (uint16_t)mv);
+            }
+            _source = ADC_CAL_CURVE;
+            return true;
+        }
+
+#if defined(ESP32) && defined(ARDUINO)
+         /**
+         * @brief Membangun tabel dari data kalibrasi eFuse (Two Point atau Vref).
+         *
+         * @param atten Atenuasi ADC yang dipakai analogRead() (default 11 dB).
+         * @return bool false jika eFuse tidak berisi kalibrasi (tabel tidak diubah).
+         */
+        bool buildFromEfuse(adc_atten_t atten = ADC_ATTEN_DB_11)
+        {
+            if (esp_adc_cal_check_efuse(ESP_ADC_CAL_VAL_EFUSE_TP) != ESP_OK &&
+                esp_adc_cal_check_efuse(ESP_ADC_CAL_VAL_EFUSE_VREF) != ESP_OK) return false;
+
+            esp_adc_cal_characteristics_t chars;
+            esp_adc_cal_characterize(ADC_UNIT_1, atten, (adc_bits_width_t)(MQ_ADC_BITS - 9), 1100, &chars);
+            for (uint32_t raw = 0; raw <= MQ_ADC_MAX; raw++) {
+                _table[raw] = (uint16_t)esp_adc_cal_raw_to_voltage(raw, &chars);
+            }
+            _source = ADC_CAL_EFUSE;
+            return true;
+        }
+#else
+        bool buildFromEfuse() { return false; } // host: tidak ada eFuse
+#endif
+
+         /**
+         * @brief Konversi kode ADC mentah ke millivolt (satu lookup).
+         */
+        inline uint16_t toMillivolts(uint32_t raw) const
+        {
+            return _table[raw > MQ_ADC_MAX ? MQ_ADC_MAX : raw];
+        }
+
+         /**
+         * @brief Konversi pembacaan beresolusi bits (>= MQ_ADC_BITS) ke millivolt,
+         * interpolasi antar entri tabel memakai bit di bawah MQ_ADC_BITS.
+         *
+         * @param value Kode ADC pada skala 0..(2^bits - 1).
+         * @param bits Resolusi value, mis. MQ_ADC_WIDE_BITS untuk oversampling.
+         */
+        inline uint16_t toMillivoltsWide(uint32_t value, uint8_t bits) const
+        {
+            if (bits <= MQ_ADC_BITS) return toMillivolts(value << (MQ_ADC_BITS - bits));
+            const int shift = bits - MQ_ADC_BITS;
+            uint32_t index = value >> shift;
+            if (index >= MQ_ADC_MAX) return _table[MQ_ADC_MAX];
+            uint32_t frac = value & ((1u << shift) - 1);
+            int32_t a = _table[index];
+            int32_t b = _table[index + 1];
+            return (uint16_t)(a + (((b - a) * (int32_t)frac) >> shift));
+        }
+
+         /**
+         * @brief Konversi pembacaan 16-bit hasil oversampling ke millivolt.
+         */
+        inline uint16_t toMillivolts16(uint16_t value) const
+        {
+            return toMillivoltsWide(value, MQ_ADC_WIDE_BITS);
+        }
+
+        AdcCalSource getSource() const { return _source; }
+
+    private:
+        uint16_t _table[MQ_ADC_MAX + 1];
+        AdcCalSource _source;
+};
+
+#endif
+
+/*
+*** Example ***
+
+#include <AdcCalibration.h>
+#include <MQMath.h>
+
+adcCalibration adcCal;
+
+void setup() {
+  analogReadResolution(MQ_ADC_BITS);
+  if (!adcCal.buildFromEfuse()) adcCal.buildLinear();
+}
+
+void loop() {
+  uint16_t mv = adcCal.toMillivolts(analogRead(34));
+  float rs = mqResistance(mv, MQ_ADC_FULL_SCALE_MV, 5.0);
+}
+
+*/
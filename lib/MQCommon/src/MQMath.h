@@ -0,0 +1,73 @@
+#ifndef MQMath_h
+#define MQMath_h
+
+#include <math.h>
+#include <stdint.h>
+#include "AdcCalibration.h"
+
+/**
+ * @brief Menghitung resistansi sensor (Rs) dari pembacaan ADC.
+ *
+ * Rangkaian pembagi tegangan dengan load resistor RL: Rs = RL * (Vmax - V) / V.
+ *
+ * @param rawAdc Nilai ADC mentah.
+ * @param adcMax Nilai ADC skala penuh (mis. 1023 untuk 10-bit).
+ * @param rl Resistansi load dalam kilo ohm.
+ * @return float Rs dalam kilo ohm.
+ */
+inline float mqResistance(float rawAdc, float adcMax, float rl)
+{
+    return rl * (adcMax - rawAdc) / rawAdc;
+}
+
+/**
+ * @brief Rs dari kode ADC beresolusi bits, lewat tabel kalibrasi bila ada.
+ *
+ * Pembacaan oversampling (MQ_ADC_WIDE_BITS) dipakai utuh: tabel diinterpolasi
+ * dan skala penuh tanpa kalibrasi ikut (2^bits - 1), bukan digeser ke MQ_ADC_BITS.
+ *
+ * @param raw Kode ADC pada skala 0..(2^bits - 1).
+ * @param bits Resolusi raw (MQ_ADC_BITS untuk analogRead()).
+ * @param cal Tabel kalibrasi, NULL untuk skala linear.
+ * @param rl Resistansi load dalam kilo ohm.
+ * @return float Rs dalam kilo ohm.
+ */
+inline float mqResistanceRaw(uint32_t raw, uint8_t bits, const adcCalibration* cal, float rl)
+{
+    if (cal) return mqResistance((float)cal->toMillivoltsWide(raw, bits), MQ_ADC_FULL_SCALE_MV, rl);
+    return mqResistance((float)raw, (float)((1UL << bits) - 1), rl);
+}
+
+/**
+ * @brief Menghitung konsentrasi gas dari rasio Rs/Ro dan kurva log-log.
+ *
+ * Memakai log natural untuk rasio seperti library MQ2 aslinya; kurva MQ2
+ * dikalibrasi bersama perilaku ini. Kurva baru dalam satuan log10 memakai
+ * mqPercentageLog10().
+ *
+ * @param rsRoRatio Rasio Rs/Ro.
+ * @param pcurve Kurva {x, y, slope} dari datasheet.
+ * @return float Konsentrasi gas dalam ppm.
+ */
+inline float mqPercentage(float rsRoRatio, const float* pcurve)
+{
+    // Single precision: FPU ESP32 hanya float, pow/log double diemulasi software
+    return powf(10.0f, ((logf(rsRoRatio) - pcurve[1]) / pcurve[2]) + pcurve[0]);
+}
+
+/**
+ * @brief Konsentrasi gas dari kurva datasheet dalam satuan log10.
+ *
+ * ppm = 10^((log10(Rs/Ro) - y) / slope + x), dengan x = log10 ppm dan
+ * y = log10 Rs/Ro pada titik acuan kurva.
+ *
+ * @param rsRoRatio Rasio Rs/Ro.
+ * @param pcurve Kurva {x, y, slope}, semua dalam log10.
+ * @return float Konsentrasi gas dalam ppm.
+ */
+inline float mqPercentageLog10(float rsRoRatio, const float* pcurve)
+{
+    return powf(10.0f, ((log10f(rsRoRatio) - pcurve[1]) / pcurve[2]) + pcurve[0]);
+}
+
+#endif
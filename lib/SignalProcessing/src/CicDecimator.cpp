@@ -0,0 +1,53 @@
+#include "CicDecimator.h"
+
+cicDecimator::cicDecimator(uint8_t order, uint8_t log2Decimation, uint8_t inputBits, uint8_t outputBits)
+{
+    if (order < 1) order = 1;
+    if (order > CIC_MAX_ORDER) order = CIC_MAX_ORDER;
+    _order = order;
+    _log2R = log2Decimation;
+    // Gain CIC = R^order, output = acc * 2^(outputBits - inputBits) / R^order
+    _shift = (int8_t)(order * log2Decimation) - (int8_t)(outputBits - inputBits);
+    reset();
+}
+
+void cicDecimator::reset()
+{
+    _phase = 0;
+    _settle = _order;
+    for (int i = 0; i < CIC_MAX_ORDER; i++) {
+        _integrator[i] = 0;
+        _comb[i] = 0;
+    }
+}
+
+bool cicDecimator::push(uint16_t sample, uint16_t& out)
+{
+    uint32_t acc = sample;
+    for (uint8_t i = 0; i < _order; i++) {
+        _integrator[i] += acc;
+        acc = _integrator[i];
+    }
+
+    if (++_phase < (1UL << _log2R)) return false;
+    _phase = 0;
+
+    for (uint8_t i = 0; i < _order; i++) {
+        uint32_t prev = _comb[i];
+        _comb[i] = acc;
+        acc -= prev;
+    }
+    if (_settle) {
+        _settle--;
+        return false;
+    }
+
+    uint32_t scaled = _shift >= 0 ? acc >> _shift : acc << -_shift;
+    out = scaled > 0xFFFF ? 0xFFFF : (uint16_t)scaled;
+    return true;
+}
+
+uint32_t cicDecimator::getDecimation()
+{
+    return 1UL << _log2R;
+}
@@ -0,0 +1,65 @@
+#ifndef CicDecimator_h
+#define CicDecimator_h
+
+#include <stdint.h>
+
+#define CIC_MAX_ORDER 4
+
+/**
+ * @brief Decimator CIC (cascaded integrator-comb) integer.
+ * 
+ * Menurunkan sample rate sebesar 2^log2Decimation sambil merata-rata,
+ * sehingga noise ADC berkurang dan resolusi efektif naik (±0.5 bit per
+ * penggandaan rasio decimation). Hanya penjumlahan/pengurangan integer,
+ * register 32-bit boleh overflow karena hasil akhirnya tetap benar
+ * (aritmetika modulo), selama inputBits + order * log2Decimation <= 32.
+ *
+ * Sebanyak order output pertama setelah reset() dibuang: comb masih berisi
+ * nol sehingga output itu belum mencapai nilai input (DC 24000 terbaca
+ * ~12000 di output pertama untuk order 2).
+ */
+class cicDecimator
+{
+    public:
+         /**
+         * @brief Konstruktor cicDecimator.
+         * 
+         * @param order Jumlah tingkat integrator/comb (1..CIC_MAX_ORDER).
+         * @param log2Decimation Log2 rasio decimation (mis. 8 untuk 256).
+         * @param inputBits Resolusi sampel masuk (mis. 12 untuk ADC ESP32).
+         * @param outputBits Skala output (mis. 16: full scale input = 65535).
+         */
+        cicDecimator(uint8_t order = 2, uint8_t log2Decimation = 8, uint8_t inputBits = 12, uint8_t outputBits = 16);
+
+         /**
+         * @brief Memasukkan satu sampel.
+         * 
+         * @param sample Sampel mentah.
+         * @param out Diisi hasil decimation jika tersedia.
+         * @return bool true jika out berisi output baru (false selama warm-up).
+         */
+        bool push(uint16_t sample, uint16_t& out);
+
+         /**
+         * @brief Mengosongkan state filter.
+         */
+        void reset();
+
+         /**
+         * @brief Rasio decimation (jumlah sampel masuk per output).
+         * 
+         * @return uint32_t Rasio decimation.
+         */
+        uint32_t getDecimation();
+
+    private:
+        uint8_t _order;
+        uint8_t _log2R;
+        int8_t _shift; // >0 geser kanan, <0 geser kiri
+        uint32_t _phase;
+        uint8_t _settle; // output warm-up yang masih harus dibuang
+        uint32_t _integrator[CIC_MAX_ORDER];
+        uint32_t _comb[CIC_MAX_ORDER];
+};
+
+#endif
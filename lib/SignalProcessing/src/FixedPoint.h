@@ -0,0 +1,202 @@
+#ifndef FixedPoint_h
+#define FixedPoint_h
+
+#include <stdint.h>
+#include <math.h>
+
+/**
+ * @brief Bilangan fixed-point Q(31-Frac).Frac bertanda di atas int32_t.
+ * 
+ * Semua operasi aritmetika saturasi (tidak pernah wrap). Nilai raw INT32_MIN
+ * dicadangkan sebagai penanda "tidak valid" (padanan NAN pada float) dan tidak
+ * pernah dihasilkan oleh aritmetika; konversi dari NAN menghasilkan nilai ini.
+ * Perkalian dan konversi dibulatkan half away from zero sehingga hasilnya
+ * deterministik dan identik di ESP32 maupun di host.
+ * 
+ * @tparam Frac Jumlah bit pecahan (16 -> Q16.16 rentang ±32768, 24 -> Q8.24 rentang ±128).
+ */
+template <int Frac>
+struct FixedPoint
+{
+    static const int32_t RAW_MAX = INT32_MAX;
+    static const int32_t RAW_MIN = INT32_MIN + 1;
+    static const int32_t RAW_INVALID = INT32_MIN;
+    static const int64_t ONE = (int64_t)1 << Frac;
+
+    int32_t raw;
+
+    FixedPoint() : raw(0) {}
+    FixedPoint(int v) : raw(saturate((int64_t)v * ONE)) {}
+    FixedPoint(float v) : raw(fromReal(v)) {}
+    FixedPoint(double v) : raw(fromReal(v)) {}
+
+    /**
+     * @brief Membuat nilai langsung dari representasi raw.
+     */
+    static FixedPoint fromRaw(int32_t r)
+    {
+        FixedPoint f;
+        f.raw = r;
+        return f;
+    }
+
+    static FixedPoint invalid() { return fromRaw(RAW_INVALID); }
+
+    bool isValid() const { return raw != RAW_INVALID; }
+
+    float toFloat() const { return isValid() ? (float)raw / (float)ONE : NAN; }
+    double toDouble() const { return isValid() ? (double)raw / (double)ONE : NAN; }
+
+    /**
+     * @brief Menjepit hasil 64-bit ke rentang raw yang valid.
+     */
+    static int32_t saturate(int64_t v)
+    {
+        if (v > RAW_MAX) return RAW_MAX;
+        if (v < RAW_MIN) return RAW_MIN;
+        return (int32_t)v;
+    }
+
+    /**
+     * @brief Pembagian integer 64-bit dibulatkan half away from zero.
+     */
+    static int64_t divRound(int64_t num, int64_t den)
+    {
+        if (den < 0) { num = -num; den = -den; }
+        return num >= 0 ? (num + den / 2) / den : -((-num + den / 2) / den);
+    }
+
+    FixedPoint operator+(FixedPoint o) const { return fromRaw(saturate((int64_t)raw + o.raw)); }
+    FixedPoint operator-(FixedPoint o) const { return fromRaw(saturate((int64_t)raw - o.raw)); }
+    FixedPoint operator-() const { return fromRaw(saturate(-(int64_t)raw)); }
+    FixedPoint operator*(FixedPoint o) const { return fromRaw(saturate(divRound((int64_t)raw * o.raw, ONE))); }
+    FixedPoint operator*(int k) const { return fromRaw(saturate((int64_t)raw * k)); }
+
+    FixedPoint operator/(FixedPoint o) const
+    {
+        if (o.raw == 0) return fromRaw(raw >= 0 ? RAW_MAX : RAW_MIN);
+        return fromRaw(saturate(divRound((int64_t)raw * ONE, o.raw)));
+    }
+
+    FixedPoint operator/(int k) const
+    {
+        if (k == 0) return fromRaw(raw >= 0 ? RAW_MAX : RAW_MIN);
+        return fromRaw(saturate(divRound(raw, k)));
+    }
+
+    FixedPoint& operator+=(FixedPoint o) { return *this = *this + o; }
+    FixedPoint& operator-=(FixedPoint o) { return *this = *this - o; }
+
+    bool operator==(FixedPoint o) const { return raw == o.raw; }
+    bool operator!=(FixedPoint o) const { return raw != o.raw; }
+    bool operator<(FixedPoint o) const { return raw < o.raw; }
+    bool operator>(FixedPoint o) const { return raw > o.raw; }
+    bool operator<=(FixedPoint o) const { return raw <= o.raw; }
+    bool operator>=(FixedPoint o) const { return raw >= o.raw; }
+
+  private:
+    template <typename R>
+    static int32_t fromReal(R v)
+    {
+        if (v != v) return RAW_INVALID;
+        R scaled = v * (R)ONE;
+        if (scaled >= (R)RAW_MAX) return RAW_MAX;
+        if (scaled <= (R)RAW_MIN) return RAW_MIN;
+        return (int32_t)(scaled >= 0 ? scaled + (R)0.5 : scaled - (R)0.5);
+    }
+};
+
+typedef FixedPoint<16> q16_16; // suhu, kelembapan, tekanan hPa
+typedef FixedPoint<24> q8_24;  // rasio/nilai kecil (|x| < 128)
+
+// === Operasi seragam untuk float, double dan FixedPoint ===
+// Dipakai kode template (filter, klasifikasi, encoder) agar satu sumber
+// bisa di-build sebagai float maupun fixed-point.
+
+template <typename T>
+struct sampleTraits {
+    static T invalid() { return (T)NAN; }
+};
+
+template <int Frac>
+struct sampleTraits<FixedPoint<Frac> > {
+    static FixedPoint<Frac> invalid() { return FixedPoint<Frac>::invalid(); }
+};
+
+inline bool isValidSample(float v) { return v == v; }
+inline bool isValidSample(double v) { return v == v; }
+template <int Frac>
+inline bool isValidSample(FixedPoint<Frac> v) { return v.isValid(); }
+
+inline float toFloat(float v) { return v; }
+inline float toFloat(double v) { return (float)v; }
+template <int Frac>
+inline float toFloat(FixedPoint<Frac> v) { return v.toFloat(); }
+
+// Bulatkan ke int terdekat (nilai ADC/ppm di channel sample_t), tidak valid = 0
+inline int sampleToInt(float v) { return v == v ? (int)lroundf(v) : 0; }
+inline int sampleToInt(double v) { return v == v ? (int)lround(v) : 0; }
+template <int Frac>
+inline int sampleToInt(FixedPoint<Frac> v) {
+    return v.isValid() ? (int)FixedPoint<Frac>::divRound(v.raw, FixedPoint<Frac>::ONE) : 0;
+}
+
+/**
+ * @brief Jumlah berjalan untuk rata-rata (moving average, rata-rata suhu).
+ * 
+ * float/double menjumlah apa adanya. FixedPoint menjumlah raw dalam int64_t
+ * sehingga jumlah tetap eksak walau melewati rentang tipe (mis. 25 sampel
+ * tekanan); hanya hasil bagi mean() yang disaturasi.
+ */
+template <typename T>
+struct sampleSum {
+    T value;
+    sampleSum() : value(0) {}
+    void add(T v) { value += v; }
+    void sub(T v) { value -= v; }
+    T mean(int n) const { return value / n; }
+};
+
+template <int Frac>
+struct sampleSum<FixedPoint<Frac> > {
+    typedef FixedPoint<Frac> F;
+    int64_t raw;
+    sampleSum() : raw(0) {}
+    void add(F v) { raw += v.raw; }
+    void sub(F v) { raw -= v.raw; }
+    F mean(int n) const { return F::fromRaw(F::saturate(F::divRound(raw, n))); }
+};
+
+inline float sampleAbs(float v) { return fabsf(v); }
+inline double sampleAbs(double v) { return fabs(v); }
+template <int Frac>
+inline FixedPoint<Frac> sampleAbs(FixedPoint<Frac> v) { return v.raw < 0 ? -v : v; }
+
+/**
+ * @brief Membulatkan ke kelipatan 0.05 terdekat (padanan roundToNearest005 float).
+ * 
+ * n = round(v * 20) dihitung eksak dari raw, hasil = n / 20 dibulatkan ke raw terdekat.
+ */
+template <int Frac>
+inline FixedPoint<Frac> roundToNearest005(FixedPoint<Frac> v)
+{
+    typedef FixedPoint<Frac> F;
+    if (!v.isValid()) return v;
+    int64_t n = F::divRound((int64_t)v.raw * 20, F::ONE);
+    return F::fromRaw(F::saturate(F::divRound(n * F::ONE, 20)));
+}
+
+#endif
+
+/*
+*** Example ***
+
+#include <FixedPoint.h>
+
+q16_16 a = 25.5f;
+q16_16 b = 1.25f;
+q16_16 c = a * b + q16_16(2);   // 33.875, saturasi jika melewati ±32768
+float f = c.toFloat();
+bool ok = isValidSample(q16_16(NAN)); // false
+
+*/
@@ -1,54 +1,84 @@
-#include <Arduino.h>
-#include "SignalProcessing.h"
+#include <stdlib.h>
 #include <math.h>
+#include "SignalProcessing.h"
 
-movingAverage::movingAverage(int bufferSize)
-    :_size(bufferSize), _index(0), _count(0), _sum(0.0f), _buffer(nullptr) {}
+template <typename T>
+basicMovingAverage<T>::basicMovingAverage(int bufferSize)
+    :_size(bufferSize), _buffer(nullptr), _index(0), _count(0), _sum(), _ownsBuffer(false) {}
 
-movingAverage::~movingAverage() {
-    if (_buffer) free(_buffer);
+template <typename T>
+basicMovingAverage<T>::~basicMovingAverage() {
+    if (_buffer && _ownsBuffer) free(_buffer);
 }
 
-bool movingAverage::init()
+template <typename T>
+bool basicMovingAverage<T>::init()
 {
-    if (_buffer) free(_buffer);
-    _buffer = (float*) calloc(_size, sizeof(float));
+    if (_buffer && _ownsBuffer) free(_buffer);
+    _buffer = (T*) calloc(_size, sizeof(T));
+    _ownsBuffer = true;
     return (_buffer != nullptr);
 }
 
-float movingAverage::update(float newData)
+template <typename T>
+bool basicMovingAverage<T>::init(T* storage)
+{
+    if (_buffer && _ownsBuffer) free(_buffer);
+    _buffer = storage;
+    _ownsBuffer = false;
+    _index = 0;
+    _count = 0;
+    _sum = sampleSum<T>();
+    if (!_buffer) return false;
+    for (int i = 0; i < _size; i++) _buffer[i] = T(0);
+    return true;
+}
+
+template <typename T>
+T basicMovingAverage<T>::update(T newData)
 {
-    if (!_buffer) return 0.0f;
-    if(_count == _size) _sum -= _buffer[_index];
+    if (!_buffer) return T(0);
+    if (!isValidSample(newData)) return getValue();
+    if(_count == _size) _sum.sub(_buffer[_index]);
     else _count++;
 
     _buffer[_index] = newData;
-    _sum += newData;
+    _sum.add(newData);
     _index = (_index + 1) % _size; 
-    return _sum / _count;
+    return _sum.mean(_count);
 }
 
-float* movingAverage::getBuffer()
+template <typename T>
+T* basicMovingAverage<T>::getBuffer()
 {
     return _buffer; 
 }
 
-float movingAverage::getValue()
+template <typename T>
+T basicMovingAverage<T>::getValue()
 {
-    if (_count == 0) return 0.0f;
-    return _sum / _count;
+    if (_count == 0) return T(0);
+    return _sum.mean(_count);
 }
 
-int movingAverage::getSize()
+template <typename T>
+int basicMovingAverage<T>::getSize()
 {
     return _size;
 }
 
-int movingAverage::getCount()
+template <typename T>
+int basicMovingAverage<T>::getCount()
 {
     return _count;
 }
 
+// Tipe yang dipakai firmware, replay dan benchmark
+template class basicMovingAverage<float>;
+template class basicMovingAverage<double>;
+template class basicMovingAverage<q16_16>;
+template class basicMovingAverage<q8_24>;
+
 float roundToNearest005(float val)
 {
     return round(val * 20) / 20;
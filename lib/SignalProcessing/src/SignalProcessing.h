@@ -1,32 +1,39 @@
 #ifndef SignalProcessing_h
 #define SignalProcessing_h
 
+#include "FixedPoint.h"
+
 /**
  * @brief Class untuk menghitung moving average (rata-rata bergerak).
  * 
  * Class ini menyimpan data dalam buffer dan menghitung rata-rata bergerak
- * berdasarkan data yang diterima.
+ * berdasarkan data yang diterima. Tipe numerik bisa float, double, q16_16
+ * atau q8_24 (diinstansiasi di SignalProcessing.cpp); dengan fixed-point
+ * jumlah berjalan eksak sehingga tidak ada drift akibat pembulatan.
+ * 
+ * @tparam T Tipe sampel.
  */
-class movingAverage
+template <typename T>
+class basicMovingAverage
 {
     public:
          /**
-         * @brief Konstruktor untuk class movingAverage.
+         * @brief Konstruktor untuk class basicMovingAverage.
          * 
          * Konstruktor ini akan menginisialisasi ukuran buffer, indeks, jumlah
          * data yang diterima, dan buffer itu sendiri.
          * 
          * @param bufferSize Ukuran dari buffer yang digunakan untuk menyimpan data.
          */
-        movingAverage(int bufferSize);
+        basicMovingAverage(int bufferSize);
 
          /**
-         * @brief Destruktor untuk class movingAverage.
+         * @brief Destruktor untuk class basicMovingAverage.
          * 
          * Fungsi ini digunakan untuk membebaskan memori yang digunakan oleh buffer
          * ketika objek dihancurkan.
          */
-        ~movingAverage();
+        ~basicMovingAverage();
 
          /**
          * @brief Menginisialisasi buffer dan memori.
@@ -35,31 +42,42 @@ class movingAverage
          */
         bool init();
 
+         /**
+         * @brief Memakai buffer eksternal (mis. dari arena) alih-alih calloc.
+         * 
+         * Buffer tidak dibebaskan oleh destruktor. Isi buffer di-reset ke 0.
+         * 
+         * @param storage Buffer minimal sebesar bufferSize elemen T.
+         * @return bool true jika storage valid.
+         */
+        bool init(T* storage);
+
          /**
          * @brief Mengupdate nilai rata-rata bergerak dengan data baru.
          * 
          * Fungsi ini menghitung rata-rata bergerak setelah menerima data baru.
          * Jika jumlah data sudah mencapai ukuran buffer, maka data yang lama
-         * akan digantikan dengan yang baru.
+         * akan digantikan dengan yang baru. Data tidak valid (NAN /
+         * FixedPoint::invalid) dilewati dan nilai saat ini dikembalikan.
          * 
          * @param newData Data baru yang akan dimasukkan ke dalam buffer.
-         * @return float Nilai rata-rata bergerak setelah data baru dimasukkan.
+         * @return T Nilai rata-rata bergerak setelah data baru dimasukkan.
          */
-        float update(float newData);
+        T update(T newData);
 
          /**
          * @brief Mengembalikan pointer ke buffer yang digunakan untuk menyimpan data.
          * 
-         * @return float* Pointer ke buffer.
+         * @return T* Pointer ke buffer.
          */
-        float* getBuffer();
+        T* getBuffer();
 
          /**
          * @brief Mengembalikan nilai rata-rata bergerak saat ini.
          * 
-         * @return float Nilai rata-rata bergerak.
+         * @return T Nilai rata-rata bergerak.
          */
-        float getValue();
+        T getValue();
 
          /**
          * @brief Mengembalikan ukuran buffer yang digunakan untuk menyimpan data.
@@ -77,13 +95,16 @@ class movingAverage
 
     private:
         int _size; 
-        float* _buffer;
+        T* _buffer;
         int _index;
         int _count;
-        float _sum;
+        sampleSum<T> _sum;
+        bool _ownsBuffer;
 
 };
 
+typedef basicMovingAverage<float> movingAverage;
+
 float roundToNearest005(float val);
 float* roundToNearest005(float* val, int size);
 
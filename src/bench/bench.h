@@ -0,0 +1,129 @@
+#ifndef BENCH_H
+#define BENCH_H
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+
+// === Backend timer ===
+// ESP32 : cycle counter CPU (ESP.getCycleCount), satuan cycles
+// Host  : std::chrono::steady_clock, satuan ns
+#ifdef ARDUINO
+#include <Arduino.h>
+#define BENCH_BACKEND "esp32-ccount"
+#define BENCH_UNIT "cycles"
+typedef uint32_t bench_ticks_t;
+inline bench_ticks_t benchNow() { return ESP.getCycleCount(); }
+#else
+#include <chrono>
+#define BENCH_BACKEND "host-steady-clock"
+#define BENCH_UNIT "ns"
+typedef uint64_t bench_ticks_t;
+inline bench_ticks_t benchNow() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+    std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+#endif
+
+#define BENCH_REPEATS 7
+#define BENCH_MAX_CASES 32
+#define BENCH_NAME_LEN 32
+
+// Satu kasus benchmark: run(n) menjalankan operasi n kali
+struct BenchCase {
+  const char* name;
+  void (*setup)();
+  void (*run)(uint32_t iterations);
+  uint32_t iterations;
+};
+
+struct BenchResult {
+  char name[BENCH_NAME_LEN];
+  double perIteration; // BENCH_UNIT per operasi
+};
+
+// Hasil terbaik (minimum) dari BENCH_REPEATS percobaan
+inline double runBenchCase(const BenchCase& c)
+{
+  if (c.setup) c.setup();
+  c.run(c.iterations / 10 + 1); // warm-up cache & branch predictor
+  double best = -1;
+  for (int r = 0; r < BENCH_REPEATS; r++) {
+    bench_ticks_t start = benchNow();
+    c.run(c.iterations);
+    bench_ticks_t elapsed = benchNow() - start;
+    double perIter = (double)elapsed / c.iterations;
+    if (best < 0 || perIter < best) best = perIter;
+  }
+  return best;
+}
+
+// === JSON baseline ===
+// {"backend":"...","unit":"...","results":[{"name":"x","value":1.23},...]}
+inline size_t formatBenchJson(const BenchResult* results, int count, char* out, size_t cap)
+{
+  size_t len = 0;
+  int n = snprintf(out, cap, "{\"backend\":\"%s\",\"unit\":\"%s\",\"results\":[", BENCH_BACKEND, BENCH_UNIT);
+  if (n < 0 || (size_t)n >= cap) return 0;
+  len += n;
+  for (int i = 0; i < count; i++) {
+    n = snprintf(out + len, cap - len, "%s\n  {\"name\":\"%s\",\"value\":%.3f}",
+                 i ? "," : "", results[i].name, results[i].perIteration);
+    if (n < 0 || (size_t)n >= cap - len) return 0;
+    len += n;
+  }
+  n = snprintf(out + len, cap - len, "\n]}\n");
+  if (n < 0 || (size_t)n >= cap - len) return 0;
+  return len + n;
+}
+
+// Parser minimal untuk JSON yang ditulis formatBenchJson()
+inline int parseBenchJson(const char* json, BenchResult* results, int maxCount)
+{
+  int count = 0;
+  const char* p = json;
+  while (count < maxCount && (p = strstr(p, "\"name\":\"")) != NULL) {
+    p += 8;
+    const char* end = strchr(p, '"');
+    if (!end) break;
+    size_t len = end - p;
+    if (len >= BENCH_NAME_LEN) len = BENCH_NAME_LEN - 1;
+    memcpy(results[count].name, p, len);
+    results[count].name[len] = '\0';
+    const char* v = strstr(end, "\"value\":");
+    if (!v) break;
+    results[count].perIteration = strtod(v + 8, NULL);
+    count++;
+    p = v;
+  }
+  return count;
+}
+
+// Bandingkan hasil dengan baseline. Return jumlah regresi di atas toleransi (%).
+inline int compareBench(const BenchResult* baseline, int baseCount,
+                        const BenchResult* current, int curCount, double tolerancePct)
+{
+  int regressions = 0;
+  printf("%-24s %12s %12s %9s\n", "case", "baseline", "current", "delta");
+  for (int i = 0; i < curCount; i++) {
+    const BenchResult* base = NULL;
+    for (int j = 0; j < baseCount; j++) {
+      if (!strcmp(baseline[j].name, current[i].name)) base = &baseline[j];
+    }
+    if (!base) {
+      printf("%-24s %12s %12.3f %9s\n", current[i].name, "-", current[i].perIteration, "new");
+      continue;
+    }
+    double delta = base->perIteration > 0
+      ? (current[i].perIteration - base->perIteration) * 100.0 / base->perIteration : 0;
+    bool regressed = delta > tolerancePct;
+    if (regressed) regressions++;
+    printf("%-24s %12.3f %12.3f %+8.1f%%%s\n", current[i].name, base->perIteration,
+           current[i].perIteration, delta, regressed ? "  REGRESI" : "");
+  }
+  return regressions;
+}
+
+#endif
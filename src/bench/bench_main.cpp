@@ -0,0 +1,316 @@
+// === Microbenchmark SignalProcessing, MQ math, tokenizer, frame encoder & ADC ===
+// Kasus *_double / *_q16 membandingkan build float, double dan fixed-point.
+//
+// Host:
+//   pio run -e bench
+//   .pio/build/bench/program [--save base.json] [--compare base.json] [--tolerance 10]
+//   .pio/build/bench/program --input esp32.json --compare base.json
+// Baseline host tersimpan di src/bench/baseline_host.json (x86-64, -O2). Angka
+// host hanya sebanding di mesin yang sama: simpan ulang dengan --save sebelum
+// membandingkan di mesin lain.
+// ESP32 (cycle counter):
+//   pio run -e bench_esp32 -t upload -t monitor
+//   Salin JSON di antara BENCH_JSON_BEGIN/END ke file, lalu bandingkan dengan --input di host.
+
+#include "bench.h"
+#include <SignalProcessing.h>
+#include <MQMath.h>
+#include <AdcCalibration.h>
+#include "sensor_config.h"
+#include "parser.h"
+#include "frame_encoder.h"
+#include "condition.h"
+#include "adc_mock.h"
+
+volatile float benchSink; // cegah compiler membuang hasil
+
+// === movingAverage::update ===
+static movingAverage benchMa(DATA_BUFFER_SIZE);
+static void maSetup() { benchMa.init(); }
+static void maRun(uint32_t n) {
+  for (uint32_t i = 0; i < n; i++) benchSink = benchMa.update((float)(i & 1023));
+}
+
+// === basicMovingAverage<double> / <q16_16>: pembanding build float ===
+static basicMovingAverage<double> benchMaDouble(DATA_BUFFER_SIZE);
+static basicMovingAverage<q16_16> benchMaQ16(DATA_BUFFER_SIZE);
+static void maDoubleSetup() { benchMaDouble.init(); }
+static void maDoubleRun(uint32_t n) {
+  for (uint32_t i = 0; i < n; i++) benchSink = benchMaDouble.update((double)(i & 1023));
+}
+static void maQ16Setup() { benchMaQ16.init(); }
+static void maQ16Run(uint32_t n) {
+  for (uint32_t i = 0; i < n; i++) benchSink = benchMaQ16.update(q16_16((int)(i & 1023))).raw;
+}
+
+// === roundToNearest005 (scalar) ===
+static void roundScalarRun(uint32_t n) {
+  float x = 12.3456f;
+  for (uint32_t i = 0; i < n; i++) {
+    benchSink = roundToNearest005(x);
+    x += 0.013f;
+  }
+}
+
+static void roundQ16Run(uint32_t n) {
+  q16_16 x = 12.3456f;
+  const q16_16 step = 0.013f;
+  for (uint32_t i = 0; i < n; i++) {
+    benchSink = roundToNearest005(x).raw;
+    x += step;
+  }
+}
+
+// === roundToNearest005 (array) ===
+static float roundSource[DATA_BUFFER_SIZE];
+static float roundWork[DATA_BUFFER_SIZE];
+static void roundArraySetup() {
+  for (int i = 0; i < DATA_BUFFER_SIZE; i++) roundSource[i] = 20.0f + i * 0.0173f;
+}
+static void roundArrayRun(uint32_t n) {
+  for (uint32_t i = 0; i < n; i++) {
+    memcpy(roundWork, roundSource, sizeof(roundWork));
+    benchSink = roundToNearest005(roundWork, DATA_BUFFER_SIZE)[i % DATA_BUFFER_SIZE];
+  }
+}
+
+// === classifyReading() float / double / q16_16 ===
+static const float classifyTempsF[expectedSensorCount] = {25.5f, 26.25f, NAN, 31.0f};
+static double classifyTempsD[expectedSensorCount];
+static q16_16 classifyTempsQ[expectedSensorCount];
+static void classifySetup() {
+  for (int i = 0; i < expectedSensorCount; i++) {
+    classifyTempsD[i] = classifyTempsF[i];
+    classifyTempsQ[i] = q16_16(classifyTempsF[i]);
+  }
+}
+static void classifyFloatRun(uint32_t n) {
+  int acc = 0;
+  for (uint32_t i = 0; i < n; i++) acc += classifyReading(classifyTempsF, expectedSensorCount, 24.0f, 45.0f, (int)(i & 511), 12);
+  benchSink = acc;
+}
+static void classifyDoubleRun(uint32_t n) {
+  int acc = 0;
+  for (uint32_t i = 0; i < n; i++) acc += classifyReading(classifyTempsD, expectedSensorCount, 24.0, 45.0, (int)(i & 511), 12);
+  benchSink = acc;
+}
+static void classifyQ16Run(uint32_t n) {
+  int acc = 0;
+  const q16_16 ambient = 24, humidity = 45;
+  for (uint32_t i = 0; i < n; i++) acc += classifyReading(classifyTempsQ, expectedSensorCount, ambient, humidity, (int)(i & 511), 12);
+  benchSink = acc;
+}
+
+// === MQ2::MQGetPercentage (Rs + kurva LPG) ===
+static const float benchLPGCurve[3] = {2.3, 0.21, -0.47}; // sama dengan MQ2.h
+static void mqRun(uint32_t n) {
+  const float ro = 9.8f;
+  for (uint32_t i = 0; i < n; i++) {
+    float rs = mqResistance((float)(100 + (i & 511)), MQ_ADC_MAX, 5.0);
+    benchSink = mqPercentage(rs / ro, benchLPGCurve);
+  }
+}
+
+// === Rs via tabel kalibrasi ADC (MQ2::MQResistanceCalculation dengan setCalibration) ===
+static adcCalibration benchAdcCal;
+static void calSetup() {
+  AdcCalCurve curve = { ADC_CAL_MAGIC, 3, { { 100, 250 }, { 500, 1500 }, { 1000, 3100 } } };
+  benchAdcCal.buildFromCurve(curve);
+}
+static void calRun(uint32_t n) {
+  for (uint32_t i = 0; i < n; i++) {
+    benchSink = mqResistance((float)benchAdcCal.toMillivolts(100 + (i & 511)), MQ_ADC_FULL_SCALE_MV, 5.0);
+  }
+}
+
+// === tokenize() ===
+static const char parseInput[] = "SID:a1b2c3d4;GAS:512;CO:12;TEMP1:25.50";
+static void tokenizeRun(uint32_t n) {
+  TokenList<8> fields;
+  for (uint32_t i = 0; i < n; i++) {
+    fields.split(parseInput, sizeof(parseInput) - 1, ";");
+    benchSink = fields[0].len;
+  }
+}
+
+// === dispatchKeyValues() ===
+static void benchOnValue(int index, const TokenSpan& v, void* ctx) {
+  *(int*)ctx += v.len + index;
+}
+static const CommandEntry benchTable[] = {
+  { "CO",   benchOnValue },
+  { "GAS",  benchOnValue },
+  { "SID",  benchOnValue },
+  { "TEMP", benchOnValue },
+};
+static void dispatchRun(uint32_t n) {
+  int acc = 0;
+  for (uint32_t i = 0; i < n; i++) {
+    dispatchKeyValues(parseInput, sizeof(parseInput) - 1, benchTable, 4, &acc);
+  }
+  benchSink = acc;
+}
+
+// === Frame builder sendDataRS485() ===
+static void frameRun(uint32_t n) {
+  float temps[expectedSensorCount] = {25.5f, 26.25f, 24.75f, 25.0f};
+  char out[FRAME_MAX_LEN];
+  FrameData f = { "a1b2c3d4e5f6", 1, 1000, 512, 12, temps, expectedSensorCount, NULL, 55.25f, 1008.75f };
+  for (uint32_t i = 0; i < n; i++) {
+    f.gas = 300 + (i & 255);
+    benchSink = encodeFrame(f, out, sizeof(out));
+  }
+}
+
+// === AdcOversampler::process (CIC, 2 channel, batch DMA 128 sampel) ===
+static SyntheticAdcDriver benchAdcDriver;
+static AdcOversampler benchAdc(benchAdcDriver);
+static AdcSample benchAdcBatch[ADC_READ_BATCH];
+static void adcSetup() {
+  const uint8_t ch[] = { 6, 7 };
+  benchAdc.begin(ch, 2, ADC_SAMPLE_RATE_HZ, ADC_CIC_ORDER, ADC_CIC_LOG2_DECIMATION);
+  SyntheticChannel s = { 1500, 300, 2, 8 };
+  benchAdcDriver.setSignal(0, s);
+  benchAdcDriver.setSignal(1, s);
+  benchAdcDriver.read(benchAdcBatch, ADC_READ_BATCH, 0);
+}
+static void adcRun(uint32_t n) {
+  uint16_t v = 0;
+  for (uint32_t i = 0; i < n; i++) {
+    benchAdc.process(benchAdcBatch, ADC_READ_BATCH);
+    benchAdc.latest(0, v); // consumer ikut mengosongkan ring
+  }
+  benchSink = v;
+}
+
+static void frameQ16Run(uint32_t n) {
+  q16_16 temps[expectedSensorCount] = {25.5f, 26.25f, 24.75f, 25.0f};
+  char out[FRAME_MAX_LEN];
+  basicFrameData<q16_16> f = { "a1b2c3d4e5f6", 1, 1000, 512, 12, temps, expectedSensorCount, NULL, 55.25f, 1008.75f };
+  for (uint32_t i = 0; i < n; i++) {
+    f.gas = 300 + (i & 255);
+    benchSink = encodeFrame(f, out, sizeof(out));
+  }
+}
+
+#ifdef ARDUINO
+#define BENCH_SCALE 1
+#else
+#define BENCH_SCALE 20
+#endif
+
+static const BenchCase benchCases[] = {
+  { "ma_update",        maSetup,          maRun,          20000 * BENCH_SCALE },
+  { "ma_update_double", maDoubleSetup,    maDoubleRun,    20000 * BENCH_SCALE },
+  { "ma_update_q16",    maQ16Setup,       maQ16Run,       20000 * BENCH_SCALE },
+  { "round005_scalar",  NULL,             roundScalarRun, 20000 * BENCH_SCALE },
+  { "round005_q16",     NULL,             roundQ16Run,    20000 * BENCH_SCALE },
+  { "round005_array25", roundArraySetup,  roundArrayRun,  2000 * BENCH_SCALE },
+  { "classify",         classifySetup,    classifyFloatRun,  5000 * BENCH_SCALE },
+  { "classify_double",  classifySetup,    classifyDoubleRun, 5000 * BENCH_SCALE },
+  { "classify_q16",     classifySetup,    classifyQ16Run,    5000 * BENCH_SCALE },
+  { "mq2_percentage",   NULL,             mqRun,          2000 * BENCH_SCALE },
+  { "mq2_rs_lut",       calSetup,         calRun,         2000 * BENCH_SCALE },
+  { "tokenize",         NULL,             tokenizeRun,    1000 * BENCH_SCALE },
+  { "dispatch",         NULL,             dispatchRun,    1000 * BENCH_SCALE },
+  { "frame_encode",     NULL,             frameRun,       1000 * BENCH_SCALE },
+  { "frame_encode_q16", NULL,             frameQ16Run,    1000 * BENCH_SCALE },
+  { "cic_decimate128",  adcSetup,         adcRun,         500 * BENCH_SCALE },
+};
+static const int benchCaseCount = sizeof(benchCases) / sizeof(benchCases[0]);
+
+static int runAll(BenchResult* results)
+{
+  for (int i = 0; i < benchCaseCount; i++) {
+    strncpy(results[i].name, benchCases[i].name, BENCH_NAME_LEN - 1);
+    results[i].name[BENCH_NAME_LEN - 1] = '\0';
+    results[i].perIteration = runBenchCase(benchCases[i]);
+  }
+  return benchCaseCount;
+}
+
+#ifdef ARDUINO
+
+void setup() {
+  Serial.begin(115200);
+  delay(1000);
+  static BenchResult results[BENCH_MAX_CASES];
+  static char json[1024];
+  int count = runAll(results);
+  size_t len = formatBenchJson(results, count, json, sizeof(json));
+  Serial.println("BENCH_JSON_BEGIN");
+  Serial.write((const uint8_t*)json, len);
+  Serial.println("BENCH_JSON_END");
+}
+
+void loop() {}
+
+#else
+
+static bool readText(const char* path, char* out, size_t cap)
+{
+  FILE* f = fopen(path, "rb");
+  if (!f) return false;
+  size_t n = fread(out, 1, cap - 1, f);
+  out[n] = '\0';
+  fclose(f);
+  return true;
+}
+
+int main(int argc, char** argv)
+{
+  const char* savePath = NULL;
+  const char* comparePath = NULL;
+  const char* inputPath = NULL;
+  double tolerance = 10.0;
+  for (int i = 1; i < argc; i++) {
+    if (!strcmp(argv[i], "--save") && i + 1 < argc) savePath = argv[++i];
+    else if (!strcmp(argv[i], "--compare") && i + 1 < argc) comparePath = argv[++i];
+    else if (!strcmp(argv[i], "--input") && i + 1 < argc) inputPath = argv[++i];
+    else if (!strcmp(argv[i], "--tolerance") && i + 1 < argc) tolerance = atof(argv[++i]);
+    else {
+      fprintf(stderr, "usage: %s [--save f] [--compare f] [--input f] [--tolerance pct]\n", argv[0]);
+      return 2;
+    }
+  }
+
+  static BenchResult current[BENCH_MAX_CASES];
+  static char json[4096];
+  int count;
+  if (inputPath) {
+    if (!readText(inputPath, json, sizeof(json))) {
+      fprintf(stderr, "cannot open %s\n", inputPath);
+      return 1;
+    }
+    count = parseBenchJson(json, current, BENCH_MAX_CASES);
+  } else {
+    count = runAll(current);
+    size_t len = formatBenchJson(current, count, json, sizeof(json));
+    fwrite(json, 1, len, stdout);
+    if (savePath) {
+      FILE* f = fopen(savePath, "wb");
+      if (!f) {
+        fprintf(stderr, "cannot write %s\n", savePath);
+        return 1;
+      }
+      fwrite(json, 1, len, f);
+      fclose(f);
+    }
+  }
+
+  if (comparePath) {
+    static char baseJson[4096];
+    static BenchResult baseline[BENCH_MAX_CASES];
+    if (!readText(comparePath, baseJson, sizeof(baseJson))) {
+      fprintf(stderr, "cannot open %s\n", comparePath);
+      return 1;
+    }
+    int baseCount = parseBenchJson(baseJson, baseline, BENCH_MAX_CASES);
+    int regressions = compareBench(baseline, baseCount, current, count, tolerance);
+    printf("%d regresi (toleransi %.1f%%)\n", regressions, tolerance);
+    return regressions ? 1 : 0;
+  }
+  return 0;
+}
+
+#endif
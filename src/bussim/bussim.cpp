@@ -0,0 +1,257 @@
+// === Simulasi bus RS485 multi-slave di host ===
+// Beberapa slave mengirim frame telemetri ke satu bus half-duplex tanpa
+// arbitrase, persis seperti firmware: tiap loop (~period ms) satu snapshot,
+// dikirim langsung (frame tunggal) atau dikumpulkan lewat FrameBatch.
+// Frame dibangun dengan encodeFrame()/FrameBatch yang sama dengan firmware,
+// sehingga panjang frame (dan airtime) sesuai kenyataan.
+//
+// Build & jalankan:
+//   pio run -e bussim
+//   .pio/build/bussim/program [--slaves <n>] [--batch <n>] [--window <ms>]
+//                             [--seconds <s>] [--period <ms>] [--turnaround <us>]
+//
+//   --slaves <n>      jumlah slave di bus (default 8)
+//   --batch <n>       N sampel per frame, 1 = tanpa batching (default: bandingkan 1 dan 4)
+//   --window <ms>     batas umur batch (default FRAME_BATCH_WINDOW_MS)
+//   --seconds <s>     lama simulasi (default 600)
+//   --period <ms>     periode loop slave (default 600, jitter +-10%)
+//   --turnaround <us> waktu DE/RE MAX485 + flush per frame (default 1000)
+//
+// Laporan: bus sibuk (termasuk airtime frame yang tabrakan), goodput (airtime
+// frame yang utuh sampai master), frame/s, sampel/s yang sampai ke master,
+// byte per sampel dan frame yang tabrakan (dua slave kirim bersamaan = kedua
+// frame rusak).
+//
+// Slave mengirim bebas tanpa arbitrase. Dengan 8 slave pada periode 600 ms
+// bus sudah jenuh dan hampir semua frame tunggal tabrakan; batching hanya
+// mengurangi, tidak menghilangkan. Topologi seperti itu butuh polling dari
+// master atau slot waktu per slave, yang belum ada di firmware ini.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <vector>
+#include <algorithm>
+#include "sensor_config.h"
+#include "frame_encoder.h"
+#include "frame_batch.h"
+
+#define RS485_BAUD 9600
+#define BITS_PER_BYTE 10 // 8N1
+#define SIM_TEMPS 4
+
+struct SimSlave {
+  char sid[17];
+  uint32_t seq;
+  FrameBatch batch;
+  uint32_t nextSampleMs;
+  float temps[SIM_TEMPS];
+  float humidity;
+  float pressure;
+  int gas;
+};
+
+struct BusFrame {
+  uint64_t startUs;
+  uint64_t endUs;
+  int samples;
+};
+
+struct SimResult {
+  uint64_t busyUs;      // bus terisi, termasuk frame yang tabrakan
+  uint64_t goodputUs;   // airtime frame yang sampai utuh
+  unsigned long frames;
+  unsigned long collided;
+  unsigned long samplesSent;
+  unsigned long samplesDelivered;
+  unsigned long bytes;
+};
+
+static uint32_t rngState = 12345;
+static uint32_t nextRandom()
+{
+  rngState ^= rngState << 13;
+  rngState ^= rngState >> 17;
+  rngState ^= rngState << 5;
+  return rngState;
+}
+
+// Acak kecil tiap sampel supaya delta tidak selalu nol
+static void walkSensors(SimSlave& s)
+{
+  for (int t = 0; t < SIM_TEMPS; t++) s.temps[t] += ((int)(nextRandom() % 21) - 10) * 0.01f;
+  s.humidity += ((int)(nextRandom() % 11) - 5) * 0.01f;
+  s.pressure += ((int)(nextRandom() % 11) - 5) * 0.01f;
+  s.gas += (int)(nextRandom() % 7) - 3;
+}
+
+static SimResult simulate(int slaves, int batchSize, uint32_t windowMs, uint32_t seconds,
+                          uint32_t periodMs, uint32_t turnaroundUs)
+{
+  rngState = 12345;
+  std::vector<SimSlave> nodes(slaves);
+  for (int i = 0; i < slaves; i++) {
+    SimSlave& s = nodes[i];
+    snprintf(s.sid, sizeof(s.sid), "%016x", 0xa1b2c300u + i);
+    s.seq = 0;
+    s.batch.setSize(batchSize);
+    s.batch.setWindow(windowMs);
+    s.nextSampleMs = nextRandom() % periodMs; // fase acak
+    for (int t = 0; t < SIM_TEMPS; t++) s.temps[t] = 25.0f + t * 0.5f;
+    s.humidity = 55.25f;
+    s.pressure = 1008.75f;
+    s.gas = 300 + i;
+  }
+
+  std::vector<BusFrame> frames;
+  char buf[FRAME_BATCH_MAX_LEN];
+  SimResult r;
+  memset(&r, 0, sizeof(r));
+  const uint32_t endMs = seconds * 1000;
+
+  for (;;) {
+    // Slave berikutnya yang mengambil sampel
+    int next = 0;
+    for (int i = 1; i < slaves; i++) {
+      if ((int32_t)(nodes[i].nextSampleMs - nodes[next].nextSampleMs) < 0) next = i;
+    }
+    SimSlave& s = nodes[next];
+    uint32_t nowMs = s.nextSampleMs;
+    if (nowMs >= endMs) break;
+
+    walkSensors(s);
+    FrameData f;
+    f.sensorId = s.sid;
+    f.seq = ++s.seq;
+    f.timeMs = nowMs;
+    f.gas = s.gas;
+    f.co = 0;
+    f.temps = s.temps;
+    f.tempCount = SIM_TEMPS;
+    f.tempErrors = NULL;
+    f.humidity = s.humidity;
+    f.pressure = s.pressure;
+
+    size_t len = 0;
+    int samples = 0;
+    if (s.batch.enabled()) {
+      s.batch.add(makeBatchSample(f));
+      if (s.batch.due(nowMs)) {
+        samples = s.batch.getCount();
+        len = s.batch.encode(s.sid, NULL, buf, sizeof(buf));
+        s.batch.clear();
+      }
+    } else {
+      len = encodeFrame(f, buf, sizeof(buf));
+      samples = 1;
+    }
+
+    if (len > 0) {
+      uint64_t airUs = (uint64_t)len * BITS_PER_BYTE * 1000000ULL / RS485_BAUD;
+      BusFrame bf;
+      bf.startUs = (uint64_t)nowMs * 1000;
+      bf.endUs = bf.startUs + turnaroundUs + airUs;
+      bf.samples = samples;
+      frames.push_back(bf);
+      r.bytes += len;
+      r.samplesSent += samples;
+    }
+
+    uint32_t jitter = periodMs / 10;
+    s.nextSampleMs = nowMs + periodMs - jitter + nextRandom() % (2 * jitter + 1);
+  }
+
+  // === Tabrakan: frame yang tumpang tindih dengan frame lain rusak ===
+  std::sort(frames.begin(), frames.end(),
+            [](const BusFrame& a, const BusFrame& b) { return a.startUs < b.startUs; });
+  std::vector<bool> bad(frames.size(), false);
+  uint64_t busyUntil = 0;
+  size_t owner = 0;
+  for (size_t i = 0; i < frames.size(); i++) {
+    const BusFrame& bf = frames[i];
+    if (i > 0 && bf.startUs < busyUntil) {
+      bad[i] = true;
+      bad[owner] = true;
+    }
+    // Waktu sibuk bus = gabungan interval
+    if (bf.startUs >= busyUntil) r.busyUs += bf.endUs - bf.startUs;
+    else if (bf.endUs > busyUntil) r.busyUs += bf.endUs - busyUntil;
+    if (bf.endUs > busyUntil) { busyUntil = bf.endUs; owner = i; }
+  }
+
+  r.frames = frames.size();
+  for (size_t i = 0; i < frames.size(); i++) {
+    if (bad[i]) {
+      r.collided++;
+    } else {
+      r.samplesDelivered += frames[i].samples;
+      r.goodputUs += frames[i].endUs - frames[i].startUs;
+    }
+  }
+  return r;
+}
+
+static void report(int slaves, int batchSize, uint32_t windowMs, uint32_t seconds, const SimResult& r)
+{
+  double secs = seconds;
+  printf("N=%d window %u ms, %d slave, %u s:\n", batchSize, (unsigned)windowMs, slaves, (unsigned)seconds);
+  printf("  bus sibuk         : %.1f %% (termasuk tabrakan)\n", 100.0 * r.busyUs / (secs * 1e6));
+  printf("  goodput           : %.1f %% (airtime frame utuh)\n", 100.0 * r.goodputUs / (secs * 1e6));
+  printf("  frame/s           : %.2f\n", r.frames / secs);
+  printf("  byte/s            : %.1f (%.1f byte/sampel)\n", r.bytes / secs,
+         r.samplesSent ? (double)r.bytes / r.samplesSent : 0.0);
+  printf("  frame tabrakan    : %lu/%lu (%.2f %%)\n", r.collided, r.frames,
+         r.frames ? 100.0 * r.collided / r.frames : 0.0);
+  printf("  sampel sampai     : %lu/%lu (%.2f sampel/s)\n", r.samplesDelivered, r.samplesSent,
+         r.samplesDelivered / secs);
+  if (r.frames && r.collided * 20 > r.frames) {
+    printf("  ⚠️ %d slave tanpa polling master / slot waktu tidak layak: %.0f %% frame rusak\n",
+           slaves, 100.0 * r.collided / r.frames);
+  }
+}
+
+int main(int argc, char** argv)
+{
+  int slaves = 8;
+  int batchSize = 0; // 0 = bandingkan 1 dan 4
+  uint32_t windowMs = FRAME_BATCH_WINDOW_MS;
+  uint32_t seconds = 600;
+  uint32_t periodMs = 600;
+  uint32_t turnaroundUs = 1000;
+
+  for (int i = 1; i < argc; i++) {
+    const char* arg = argv[i];
+    const char* val = i + 1 < argc ? argv[i + 1] : NULL;
+    if (!val) {
+      fprintf(stderr, "Opsi tidak dikenal: %s\n", arg);
+      return 1;
+    }
+    if (strcmp(arg, "--slaves") == 0) slaves = atoi(val);
+    else if (strcmp(arg, "--batch") == 0) batchSize = atoi(val);
+    else if (strcmp(arg, "--window") == 0) windowMs = strtoul(val, NULL, 10);
+    else if (strcmp(arg, "--seconds") == 0) seconds = strtoul(val, NULL, 10);
+    else if (strcmp(arg, "--period") == 0) periodMs = strtoul(val, NULL, 10);
+    else if (strcmp(arg, "--turnaround") == 0) turnaroundUs = strtoul(val, NULL, 10);
+    else {
+      fprintf(stderr, "Opsi tidak dikenal: %s\n", arg);
+      return 1;
+    }
+    i++;
+  }
+  if (slaves < 1 || periodMs < 10 || seconds < 1) {
+    fprintf(stderr, "Parameter tidak valid\n");
+    return 1;
+  }
+
+  if (batchSize > 0) {
+    report(slaves, batchSize, windowMs, seconds,
+           simulate(slaves, batchSize, windowMs, seconds, periodMs, turnaroundUs));
+    return 0;
+  }
+
+  int sizes[] = { 1, 4 };
+  for (int n : sizes) {
+    report(slaves, n, windowMs, seconds, simulate(slaves, n, windowMs, seconds, periodMs, turnaroundUs));
+  }
+  return 0;
+}
@@ -0,0 +1,256 @@
+// === Simulasi master + slave untuk trace latensi di host ===
+// Slave memakai SampleStamp/encodeFrame/appendTrace/encodeSyncReply yang sama
+// dengan firmware, dengan jam millis() sendiri (offset + drift kristal).
+// Master memakai LatencyCollector (latency_stats.h): SYNC berkala, lalu
+// distribusi latensi per tahap, end-to-end dan loss per node. Karena waktu
+// sebenarnya diketahui, galat estimasi sync dan end-to-end ikut dilaporkan.
+//
+// Build & jalankan:
+//   pio run -e latsim
+//   .pio/build/latsim/program [--slaves <n>] [--seconds <s>] [--loss <pct>]
+//                             [--batch <n>] [--sync <ms>] [--drift <ppm>]
+//   .pio/build/latsim/program --capture master.log
+//
+//   --slaves <n>   jumlah slave (default 4)
+//   --seconds <s>  lama simulasi (default 600)
+//   --loss <pct>   persen frame hilang di bus (default 1)
+//   --batch <n>    N sampel per frame (default 1, lihat frame_batch.h)
+//   --sync <ms>    periode SYNC master ke tiap slave (default 10000)
+//   --drift <ppm>  drift kristal maksimum slave, acak +- (default 50)
+//   --capture <f>  analisis log master asli: satu baris per frame,
+//                  "<ms_master> <frame>" (spasi atau tab)
+//
+// Bus dimodelkan tanpa tabrakan (lihat bussim untuk itu); loss acak saja.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <vector>
+#include <algorithm>
+#include "sensor_config.h"
+#include "frame_encoder.h"
+#include "frame_batch.h"
+#include "latency_trace.h"
+#include "latency_stats.h"
+
+#define RS485_BAUD 9600
+#define BITS_PER_BYTE 10 // 8N1
+#define SIM_TEMPS 4
+#define SIM_PERIOD_US 600000   // satu loop firmware: readData + serviceDelay(500)
+#define SIM_SERVICE_DELAY_US 500000
+#define SIM_READ_BUSY_US 250000 // readData tidak melayani RS485 selama ini
+
+static uint32_t rngState = 12345;
+static uint32_t nextRandom()
+{
+  rngState ^= rngState << 13;
+  rngState ^= rngState >> 17;
+  rngState ^= rngState << 5;
+  return rngState;
+}
+
+// Bilangan acak seragam [lo, hi]
+static int64_t uniform(int64_t lo, int64_t hi)
+{
+  return lo + (int64_t)(nextRandom() % (uint32_t)(hi - lo + 1));
+}
+
+static int64_t airtimeUs(size_t len)
+{
+  return (int64_t)len * BITS_PER_BYTE * 1000000LL / RS485_BAUD;
+}
+
+struct SimNode {
+  char sid[17];
+  int64_t offsetUs; // jam slave = waktu asli * (1 + ppm) + offset
+  double ppm;
+  uint32_t seq;
+  SampleStamp stamp;
+  FrameBatch batch;
+  std::vector<int64_t> pendingAcquire; // waktu asli akuisisi sampel dalam batch
+
+  uint32_t micros(int64_t trueUs) const { return (uint32_t)(int64_t)(trueUs * (1.0 + ppm * 1e-6) + offsetUs); }
+  uint32_t millis(int64_t trueUs) const { return (uint32_t)((int64_t)(trueUs * (1.0 + ppm * 1e-6) + offsetUs) / 1000); }
+  int64_t trueOffsetMs(int64_t trueUs) const { return (int64_t)millis(trueUs) - trueUs / 1000; }
+};
+
+// Satu baris di bus menuju master
+struct BusLine {
+  int64_t rxUs;
+  int node;
+  std::string text;
+  std::vector<int64_t> acquireUs; // waktu asli akuisisi tiap sampel (kosong untuk SYNC)
+};
+
+static void runCapture(const char* path)
+{
+  FILE* f = fopen(path, "r");
+  if (!f) {
+    fprintf(stderr, "Gagal membuka %s\n", path);
+    exit(1);
+  }
+  LatencyCollector stats;
+  char line[1024];
+  unsigned long lines = 0;
+  while (fgets(line, sizeof(line), f)) {
+    char* rest;
+    long long rxMs = strtoll(line, &rest, 10);
+    if (rest == line) continue;
+    while (*rest == ' ' || *rest == '\t') rest++;
+    stats.onLine(rest, strlen(rest), rxMs);
+    lines++;
+  }
+  fclose(f);
+  printf("==== Analisis capture %s: %lu baris, %lu diabaikan ====\n", path, lines, stats.getIgnored());
+  stats.report(stdout);
+}
+
+int main(int argc, char** argv)
+{
+  int slaves = 4;
+  uint32_t seconds = 600;
+  double lossPct = 1;
+  int batchSize = 1;
+  uint32_t syncMs = 10000;
+  double driftPpm = 50;
+
+  for (int i = 1; i < argc; i++) {
+    const char* arg = argv[i];
+    const char* val = i + 1 < argc ? argv[i + 1] : NULL;
+    if (!val) {
+      fprintf(stderr, "Opsi tidak dikenal: %s\n", arg);
+      return 1;
+    }
+    if (strcmp(arg, "--capture") == 0) {
+      runCapture(val);
+      return 0;
+    }
+    if (strcmp(arg, "--slaves") == 0) slaves = atoi(val);
+    else if (strcmp(arg, "--seconds") == 0) seconds = strtoul(val, NULL, 10);
+    else if (strcmp(arg, "--loss") == 0) lossPct = atof(val);
+    else if (strcmp(arg, "--batch") == 0) batchSize = atoi(val);
+    else if (strcmp(arg, "--sync") == 0) syncMs = strtoul(val, NULL, 10);
+    else if (strcmp(arg, "--drift") == 0) driftPpm = atof(val);
+    else {
+      fprintf(stderr, "Opsi tidak dikenal: %s\n", arg);
+      return 1;
+    }
+    i++;
+  }
+  if (slaves < 1 || seconds < 1 || syncMs < 100) {
+    fprintf(stderr, "Parameter tidak valid\n");
+    return 1;
+  }
+
+  std::vector<SimNode> nodes(slaves);
+  for (int i = 0; i < slaves; i++) {
+    SimNode& n = nodes[i];
+    snprintf(n.sid, sizeof(n.sid), "%016x", 0xa1b2c300u + i);
+    n.offsetUs = uniform(0, 3600000000LL); // slave boot kapan saja dalam 1 jam terakhir
+    n.ppm = ((int64_t)(nextRandom() % 2001) - 1000) * driftPpm / 1000.0;
+    n.seq = 0;
+    n.batch.setSize(batchSize);
+  }
+
+  // === Slave: bangkitkan semua baris ke master ===
+  std::vector<BusLine> bus;
+  const int64_t endUs = (int64_t)seconds * 1000000;
+  char buf[FRAME_BATCH_MAX_LEN];
+  unsigned long generated = 0, dropped = 0;
+  float temps[SIM_TEMPS] = { 25.5f, 26.25f, 24.75f, 25.0f };
+
+  for (int i = 0; i < slaves; i++) {
+    SimNode& n = nodes[i];
+
+    // SYNC: master kirim t0, slave baru membalas saat pollMasterCommands() jalan
+    for (int64_t t = uniform(0, syncMs * 1000LL); t < endUs; t += syncMs * 1000LL) {
+      char req[SYNC_FRAME_MAX];
+      int64_t arrive = t + airtimeUs(snprintf(req, sizeof(req), "SID:%s;SYNC:%lld\n", n.sid, (long long)(t / 1000)));
+      int64_t t0 = arrive / 1000; // master mencatat t0 setelah flush
+      bool busy = nextRandom() % 100 < SIM_READ_BUSY_US * 100 / SIM_PERIOD_US;
+      int64_t handled = arrive + (busy ? uniform(0, SIM_READ_BUSY_US) : uniform(0, 1000));
+      size_t len = encodeSyncReply(n.sid, (uint64_t)t0, n.millis(handled), n.millis(handled + 100), buf, sizeof(buf));
+      BusLine l;
+      l.rxUs = handled + 100 + airtimeUs(len);
+      l.node = i;
+      l.text.assign(buf, len);
+      generated++;
+      if (nextRandom() % 10000 < lossPct * 100) { dropped++; continue; }
+      bus.push_back(l);
+    }
+
+    // Siklus sampel: akuisisi -> filter -> klasifikasi -> serviceDelay -> encode -> kirim
+    for (int64_t t = uniform(0, SIM_PERIOD_US); t < endUs; t += SIM_PERIOD_US + uniform(-20000, 20000)) {
+      int64_t tFilter = t + uniform(150, 400);
+      int64_t tClassify = tFilter + uniform(30, 80);
+      int64_t tEncode = tClassify + SIM_SERVICE_DELAY_US + uniform(0, 20000);
+      int64_t tTransmit = tEncode + uniform(200, 500);
+
+      n.stamp.begin(n.millis(t), n.micros(t));
+      n.stamp.mark(STAGE_FILTER, n.micros(tFilter));
+      n.stamp.mark(STAGE_CLASSIFY, n.micros(tClassify));
+      n.stamp.seq = ++n.seq;
+      n.stamp.mark(STAGE_ENCODE, n.micros(tEncode));
+
+      FrameData f = { n.sid, n.stamp.seq, n.stamp.timeMs, 300, 0, temps, SIM_TEMPS, NULL, 55.25f, 1008.75f };
+      size_t len;
+      if (n.batch.enabled()) {
+        n.batch.add(makeBatchSample(f));
+        n.pendingAcquire.push_back(t);
+        if (!n.batch.due(n.millis(tEncode))) continue;
+        len = n.batch.encode(n.sid, NULL, buf, sizeof(buf) - 1);
+        n.batch.clear();
+      } else {
+        len = encodeFrame(f, buf, sizeof(buf) - 1);
+        n.pendingAcquire.push_back(t);
+      }
+      len = appendTrace(buf, len, sizeof(buf) - 1, n.stamp, n.micros(tTransmit));
+
+      BusLine l;
+      l.rxUs = tTransmit + airtimeUs(len);
+      l.node = i;
+      l.text.assign(buf, len);
+      l.acquireUs.swap(n.pendingAcquire);
+      generated++;
+      if (nextRandom() % 10000 < lossPct * 100) { dropped++; continue; }
+      bus.push_back(l);
+    }
+  }
+
+  // === Master: proses baris sesuai urutan tiba ===
+  std::sort(bus.begin(), bus.end(), [](const BusLine& a, const BusLine& b) { return a.rxUs < b.rxUs; });
+  LatencyCollector stats;
+  std::vector<LatencyDist> e2eError(slaves); // |e2e terukur - e2e asli|, ms
+  std::vector<LatencyDist> syncError(slaves);
+  for (size_t k = 0; k < bus.size(); k++) {
+    const BusLine& l = bus[k];
+    int64_t rxMs = l.rxUs / 1000;
+    stats.onLine(l.text.data(), l.text.size(), rxMs);
+
+    const SimNode& n = nodes[l.node];
+    const NodeStats& ns = stats.getNodes().find(n.sid)->second;
+    if (!ns.sync.valid()) continue;
+    int64_t err = ns.sync.offsetMs() - n.trueOffsetMs(l.rxUs);
+    syncError[l.node].add((uint32_t)(err < 0 ? -err : err));
+    for (size_t s = 0; s < l.acquireUs.size(); s++) {
+      int64_t trueE2e = rxMs - l.acquireUs[s] / 1000;
+      int64_t measured = rxMs - ns.sync.toMaster(n.millis(l.acquireUs[s]));
+      int64_t diff = measured - trueE2e;
+      e2eError[l.node].add((uint32_t)(diff < 0 ? -diff : diff));
+    }
+  }
+
+  printf("==== Simulasi latensi: %d slave, %u s, loss %.1f %%, batch %d, SYNC %u ms ====\n",
+         slaves, (unsigned)seconds, lossPct, batchSize, (unsigned)syncMs);
+  printf("baris dikirim %lu, hilang %lu\n", generated, dropped);
+  stats.report(stdout);
+  printf("==== Galat terhadap waktu asli ====\n");
+  for (int i = 0; i < slaves; i++) {
+    printf("node %s (drift %+.1f ppm): galat offset p50 %u / max %u ms, galat e2e p50 %u / max %u ms\n",
+           nodes[i].sid, nodes[i].ppm,
+           (unsigned)syncError[i].percentile(50), (unsigned)syncError[i].max(),
+           (unsigned)e2eError[i].percentile(50), (unsigned)e2eError[i].max());
+  }
+  return 0;
+}
@@ -1,17 +1,45 @@
 #include <Wire.h>
-#include <Adafruit_Sensor.h>
-#include <Adafruit_BME280.h>
 #include <OneWire.h>
 #include <DallasTemperature.h>
 #include <MQ2.h>
 #include <SignalProcessing.h>
 #include "rs485_comm.h"
 #include "eeprom_storage.h"
+#include "sensor_config.h"
+#include "sample_type.h"
+#include "condition.h"
+#include "frame_encoder.h"
+#include "parser.h"
+#include "heap_stats.h"
+#include "sensor_arena.h"
+#include "log.h"
+#include "bme280_burst.h"
+#include "ds18b20_bus.h"
+#include "alarm_channel.h"
+#include "frame_batch.h"
+#include "latency_trace.h"
+#include "sensor_channels.h"
+#include "sensor_driver.h"
+#include "sensor_drivers.h"
+#include "slave_loop.h"
 #include <MQ7.h>
+#include <AdcCalibration.h>
+#ifdef ADC_OVERSAMPLING
+#include "adc_engine.h"
+#include "adc_driver_esp32.h"
+#endif
+#ifdef BT_STREAM
+#include "bluetooth.h"
+#endif
+#ifdef TRACE_RECORD
+#include <LittleFS.h>
+#include "trace_format.h"
+#endif
 
 // === PIN SETUP ===
 #define MQ2_PIN 34       // Analog input for MQ-2
 #define MQ7_PIN 35       // Analog input for MQ-7
+#define MQ7_HEATER_PIN 26 // PWM heater MQ-7 (via MOSFET)
 #define ONE_WIRE_BUS 4   // DS18B20 data pin
 #define RS485_DE_PIN 32  // RS485 DE pin
 #define RS485_RE_PIN 33  // RS485 RE pin
@@ -21,257 +49,511 @@
 #define BME280_SCL 22   // BME280 SCL pin
 #define BUZZER_PIN 25 // Buzzer pin
 
-// === Other Define ===
-#define intervalDataRead 500
-#define expectedSensorCount 4
-#define DATA_BUFFER_SIZE 25
-#define DATA_READ_PER_INTERVAL 2
-
 // === MQ2 ===
-int mq2Value = 0;
 MQ2 mq2(MQ2_PIN);
-movingAverage lpgValue(DATA_BUFFER_SIZE);
-movingAverage coValue(DATA_BUFFER_SIZE);
-movingAverage smokeValue(DATA_BUFFER_SIZE);
+bool mq2RoLogged = false; // Ro dikalibrasi MQ2Driver setelah warm-up
+sampleAverage lpgValue(DATA_BUFFER_SIZE);
+sampleAverage coValue(DATA_BUFFER_SIZE);
+sampleAverage smokeValue(DATA_BUFFER_SIZE);
 
 // === MQ7 ===
-int mq7Value = 0;
-MQ7 mq7(MQ7_PIN, 5.0);
+MQ7 mq7(MQ7_PIN, MQ7_HEATER_PIN, 5.0);
+
+#ifdef ADC_OVERSAMPLING
+// === ADC continuous (GPIO34 = ADC1_CH6, GPIO35 = ADC1_CH7) ===
+Esp32AdcDmaDriver adcDriver;
+AdcOversampler adcEngine(adcDriver);
+const uint8_t adcChannels[] = { ADC1_CHANNEL_6, ADC1_CHANNEL_7 };
+enum { ADC_IDX_MQ2, ADC_IDX_MQ7 };
+
+// Pembacaan 16-bit dipakai utuh sampai kalibrasi/Rs (lihat mqResistanceRaw)
+#define MQ_READ_BITS MQ_ADC_WIDE_BITS
+
+uint16_t adcReadMQ7()
+{
+  uint16_t v = 0;
+  adcEngine.latest(ADC_IDX_MQ7, v);
+  return v;
+}
+#else
+#define MQ_READ_BITS MQ_ADC_BITS
+#endif
+
+// === Pembacaan raw MQ2 (16-bit DMA + CIC atau analogRead), skala MQ_READ_BITS ===
+uint16_t readMQ2Raw()
+{
+#ifdef ADC_OVERSAMPLING
+  uint16_t v = 0;
+  adcEngine.latest(ADC_IDX_MQ2, v); // belum ada output = 0
+  return v;
+#else
+  return analogRead(MQ2_PIN);
+#endif
+}
 
 // === BME280 ===
-Adafruit_BME280 bme;
+BME280Burst bme;
+BME280Config bmeConfig = { BME280_OS_X1, BME280_OS_X1, BME280_OS_X1, BME280_FILTER_OFF };
 #define SEALEVELPRESSURE_HPA (1013.25)
-movingAverage bmeHumidity(DATA_BUFFER_SIZE);
-movingAverage bmePressure(DATA_BUFFER_SIZE);
+sampleAverage bmeHumidity(DATA_BUFFER_SIZE);
+sampleAverage bmePressure(DATA_BUFFER_SIZE);
+sampleAverage bmeTemperature(DATA_BUFFER_SIZE);
 
 // === DS18B20 ===
 OneWire oneWire(ONE_WIRE_BUS);
 DallasTemperature ds18b20(&oneWire);
-DeviceAddress ds18b20Addresses[4];
-int actualSensorCount = 0;
-float** ds18b20Temp;
+DS18B20Bus ds18b20Bus(oneWire, ds18b20);
+const int tempChannels = DS18B20_MAX_SENSORS; // slot DS18B20 di ChannelBank
+uint32_t tempErrors[DS18B20_MAX_SENSORS];
+
+// === Registry driver sensor (urutan = index bit hasil scheduler) ===
+MQ2Driver mq2Driver(mq2, readMQ2Raw, MQ_READ_BITS);
+MQ7Driver mq7Driver(mq7);
+DS18B20Driver ds18b20Driver(ds18b20Bus, ds18b20);
+BME280Driver bmeDriver(bme, 0x76, bmeConfig); // 0x76 or 0x77 depending on your module
+enum { DRV_MQ2, DRV_MQ7, DRV_DS18B20, DRV_BME280 };
+SensorDriver* const sensorDrivers[] = {
+  &mq2Driver,
+  &mq7Driver,
+  &ds18b20Driver,
+  &bmeDriver,
+};
+const size_t sensorDriverCount = sizeof(sensorDrivers) / sizeof(sensorDrivers[0]);
+uint32_t sensorClockUs() { return micros(); }
+SensorScheduler sensorScheduler(sensorDrivers, sensorDriverCount, sensorClockUs);
+ChannelBank channels;
+
+// === Arena riwayat sensor (satu alokasi) ===
+SensorArena sensorArena;
+enum ArenaRing { RING_LPG, RING_CO, RING_SMOKE, RING_HUMIDITY, RING_PRESSURE, RING_BME_TEMP, RING_COUNT };
 
 // === EEPROM ===
 EEPROMStorage memory;
 #define MAGIC_ADDR 0
 #define MAGIC_NUMBER 0xDEADBEEF
 #define ID_ADDR 4
+#define ADC_CAL_ADDR 64 // AdcCalCurve, diisi saat kalibrasi bench
 String sensorID;
 
+// === ADC calibration (dipakai bersama MQ2 & MQ7) ===
+adcCalibration adcCal;
+
 // === Buzzer ===
 unsigned long previousBuzzerMillis = 0;
 int buzzerState = LOW;
 int buzzerInterval = 0;
 
-// === Global Variable ===
-uint64_t lastDataRead = 0;
-int dataIndex = 0;
-
 // === MAX485 ===
 #define RS485_BAUD 9600
 RS485Comm rs485(Serial2, RS485_DE_PIN, RS485_RE_PIN, RS485_BAUD); // DE = GPIO32, RE = GPIO33
 
+// === Frame TX statis (tanpa String/heap) ===
+char txFrame[FRAME_MAX_LEN];
+#define HEAP_REPORT_FRAMES 1200 // ~10 menit
+HeapStats heapAtBoot;
+uint32_t framesSent = 0;
+uint32_t framesDeferred = 0; // frame rutin ditunda karena alarm menunggu ACK
+bool frameDeferred = false;  // kirim snapshot terbaru setelah ACK/menyerah
+
+// === Alarm prioritas (lihat alarm_channel.h) ===
+AlarmChannel alarmChannel;
+char alarmFrame[ALARM_FRAME_MAX];
+#define ALARM_LATENCY_TARGET_US 50000
+int lastCondition = CONDITION_NORMAL;
+
+// === Batching frame (lihat frame_batch.h) ===
+FrameBatch frameBatch(FRAME_BATCH_SIZE, FRAME_BATCH_WINDOW_MS);
+char batchFrame[FRAME_BATCH_MAX_LEN];
+uint32_t batchesSent = 0;
+uint32_t samplesBatched = 0;
+
+// === Trace latensi & nomor urut sampel (lihat latency_trace.h) ===
+SampleStamp sampleStamp;
+uint32_t publishSeq = 0;
+
+// === Perintah dari master ===
+#define RX_LINE_MAX 96
+char rxLine[RX_LINE_MAX];
+size_t rxLen = 0;
+
+struct MasterCommand {
+  bool addressed; // SID cocok dengan sensorID (atau broadcast "*")
+  bool broadcast; // SID:* (tidak dibalas agar slave tidak bertabrakan)
+  bool hasAck;    // ACK:<seq> untuk alarm
+  long ackSeq;
+  long batchSize;   // BN:<n>, -1 = tidak diubah
+  long batchWindow; // BW:<ms>, -1 = tidak diubah
+  bool hasSync;     // SYNC:<t0> jam master, tanpa tanda 64 bit
+  uint64_t syncT0;
+};
+
+// === Trace Recorder (build flag -D TRACE_RECORD) ===
+#ifdef TRACE_RECORD
+#define TRACE_FILE "/trace.bin"
+File traceFile;
+TraceRecorder<File> traceRecorder(traceFile);
+#endif
+
+#ifdef BT_STREAM
+// === Streaming sampel mentah ke laptop (commissioning) ===
+#define STREAM_BATCH_SAMPLES 16
+BluetoothComm bt("FireMonitor-Stream");
+#endif
+
 // === Funcs ===
-void printAddress(DeviceAddress deviceAddress);
+void formatAddress(const DeviceAddress deviceAddress, char* out);
 void sensorInit();
 void readData();
 void sendDataRS485();
 void setNewID();
 bool idCheck();
-float avgArray(float** arr, int size);
+const sample_t* latestTemps();
 int classifyCondition();
 void buzzerAlert();
+void traceInit();
+void adcCalInit();
+void pollMasterCommands();
+void reportHeap();
+void reportSensorCost();
+void sendAlarm(uint32_t sampleUs);
+void flushBatch();
+void transmitFrame(char* frame, size_t len, size_t cap);
+void serviceDelay(uint32_t ms);
+void onCmdACK(int index, const TokenSpan& value, void* ctx);
+void onCmdBN(int index, const TokenSpan& value, void* ctx);
+void onCmdBW(int index, const TokenSpan& value, void* ctx);
+void onCmdSID(int index, const TokenSpan& value, void* ctx);
+void onCmdSYNC(int index, const TokenSpan& value, void* ctx);
+
+// Tabel perintah master, HARUS terurut berdasarkan key
+const CommandEntry masterCommands[] = {
+  { "ACK",  onCmdACK },
+  { "BN",   onCmdBN },
+  { "BW",   onCmdBW },
+  { "SID",  onCmdSID },
+  { "SYNC", onCmdSYNC },
+};
+const size_t masterCommandCount = sizeof(masterCommands) / sizeof(masterCommands[0]);
+
+// === Jadwal loop() (sama dengan simulasi host, lihat slave_loop.h) ===
+uint32_t sensorClockMs() { return millis(); }
+const SlaveLoopSteps loopSteps = { pollMasterCommands, readData, buzzerAlert, sendDataRS485, serviceDelay };
+SlaveLoop slaveLoop(sensorScheduler, sensorClockMs, loopSteps);
 
 
 void setup() {
   Serial.begin(115200);
+  logBegin();
   memory.begin();
   delay(1000);
 
-  // === Start DS18B20 ===
-  ds18b20.begin();
-  actualSensorCount = ds18b20.getDeviceCount();
-
-  Serial.printf("🔍 Mendeteksi %d DS18B20 sensor...\n", actualSensorCount);
-
-  for (int i = 0; i < actualSensorCount && i < expectedSensorCount; i++) {
-    if (ds18b20.getAddress(ds18b20Addresses[i], i)) {
-      Serial.print("Sensor ");
-      Serial.print(i);
-      Serial.print(" address: ");
-      printAddress(ds18b20Addresses[i]);
-    } else {
-      Serial.printf("❌ Gagal membaca address sensor %d\n", i);
-    }
-  }
-
-  // === Start BME280 ===
-  if (!bme.begin(0x76)) { // 0x76 or 0x77 depending on your module
-    Serial.println("❌ BME280 not found. Check wiring!");
-    while (1);
+  // === Bus sensor & analog inputs ===
+  Wire.begin(BME280_SDA, BME280_SCL);
+  analogReadResolution(MQ_ADC_BITS);
+  adcCalInit();
+  mq2.setCalibration(&adcCal);
+  mq7.setCalibration(&adcCal);
+#ifdef ADC_OVERSAMPLING
+  mq2.setReader(readMQ2Raw, MQ_READ_BITS); // tidak ada analogRead() di ADC1 selama DMA
+  mq7.setReader(adcReadMQ7, MQ_READ_BITS);
+#endif
+
+#ifdef ADC_OVERSAMPLING
+  if (adcEngine.begin(adcChannels, 2, ADC_SAMPLE_RATE_HZ, ADC_CIC_ORDER, ADC_CIC_LOG2_DECIMATION)) {
+    adcEngine.startTask();
+    LOG_I("🎞️ ADC DMA %d Hz, output %d Hz/channel", ADC_SAMPLE_RATE_HZ, (int)adcEngine.outputRateHz());
+  } else {
+    LOG_E("❌ ADC DMA init gagal");
   }
-
-  // === Start MQ2 ===
-  mq2.begin();
-
-  // === Setup analog inputs ===
-  analogReadResolution(10); // ESP32 uses 12-bit ADC
+#endif
 
   rs485.begin();
+  if (!isCommandTableSorted(masterCommands, masterCommandCount)) {
+    LOG_E("❌ masterCommands tidak terurut, perintah master bisa tidak dikenali");
+  }
   sensorInit();
+  traceInit();
+#ifdef BT_STREAM
+  bt.begin();
+  bt.startStream(STREAM_BATCH_SAMPLES);
+#endif
   if(idCheck())
   {
-    String id = memory.readString(4);
-    Serial.printf("ID yang ada: %s\n", id);
+    sensorID = memory.readString(ID_ADDR);
+    LOG_I("ID yang ada: %s", sensorID.c_str());
   }
   else
   {
     setNewID();
   }
+  heapAtBoot = readHeapStats();
 }
 
 void loop() {
-  readData();
-  delay(500);
-  buzzerAlert();
-  sendDataRS485();
+  slaveLoop.run();
 }
 
 
 void readData()
 {
-  
-  if(intervalDataRead < millis() - lastDataRead)
-  {
-    for(int i = 0; i < DATA_READ_PER_INTERVAL; i++)
-    {
-      // === Read MQ Sensors ===
-      // lpgValue.update(mq2.readLPG());
-      // coValue.update(mq2.readCO());
-      // smokeValue.update(mq2.readSmoke());
-      mq2Value = analogRead(MQ2_PIN);
-      mq7Value = mq7.getPPM();
-
-      // === Read DS18B20 ===
-      ds18b20.requestTemperatures();
-      delay(50);
-      for (int j = 0; j < actualSensorCount; j++) {
-        if(ds18b20Temp[j] != NULL)
-        {
-          ds18b20Temp[j][dataIndex] = ds18b20.getTempC(ds18b20Addresses[j]);
-        }
-      }
-
-      // === Read BME280 ===
-      bmeHumidity.update(bme.readHumidity());
-      bmePressure.update(bme.readPressure() / 100.0F);
-
-      // === Output to Serial ===
-      Serial.println("==== Sensor Readings ====");
-      Serial.printf("MQ2 LPG     : %.2f ppm\n", mq2.readLPG());
-      Serial.printf("MQ2 CO      : %.2f ppm\n", mq2.readCO());
-      Serial.printf("MQ2 Smoke   : %.2f ppm\n", mq2.readSmoke());
-      Serial.printf("MQ7 CO      : %d\n", mq7Value);
-      // Serial.println("==== DS18B20 Temperatures ====");
-      // for (int j = 0; j < actualSensorCount; j++) {
-      //   if(ds18b20Temp[j] != NULL)
-      //   {
-      //     Serial.printf("DS18B20 %d : %.2f °C\n", ds18b20Addresses[j], ds18b20Temp[j][dataIndex]);
-      //   }
-      // }
-      // Serial.println("==== BME280 Readings ====");
-      // Serial.printf("BME280 Humid : %.2f %%\n", bmeHumidity.getValue());
-      // Serial.printf("BME280 Press : %.2f hPa\n", bmePressure.getValue());
-      
-      Serial.println("==== Kondisi ====");
-      int condition = classifyCondition();
-      if (condition == 3) {
-        Serial.println("🔥 Kebakaran terdeteksi!");
-      } else if (condition == 2) {
-        Serial.println("🚨 Bahaya terdeteksi!");
-      } else if (condition == 1) {
-        Serial.println("⚠️ Waspada!");
-      } else {
-        Serial.println("✅ Ruangan Aman");
-      }
-      Serial.println("==========================\n");
+  // === Poll hanya driver yang jatuh tempo (lihat sensor_driver.h) ===
+  uint32_t produced = sensorScheduler.run(millis(), channels);
+  if (!produced) return;
+
+  uint32_t sampleUs = micros(); // sampel lengkap, awal ukur latensi alarm
+  sampleStamp.begin(millis(), sampleUs);
+  if (produced & (1UL << DRV_MQ7)) {
+    if (mq7.getLatchCount() == 1) LOG_I("🧪 MQ7 Ro %.2f kohm (siklus pertama, udara bersih)", mq7.getRo());
+    LOG_D("MQ7 latch Rs %.2f kohm -> %.1f ppm", mq7.getRs(), mq7.getPPM());
+  }
+  if ((produced & (1UL << DRV_MQ2)) && !mq2RoLogged && mq2.isCalibrated()) {
+    mq2RoLogged = true;
+    LOG_I("🧪 MQ2 Ro %.2f kohm (setelah warm-up)", mq2.getRo());
+  }
 
-      dataIndex = (dataIndex + 1) % DATA_BUFFER_SIZE;
-      delay(50);
-    }
-    lastDataRead = millis();
+#ifdef BT_STREAM
+  // === Sampel mentah (sebelum filter) ke stream, tidak pernah blocking ===
+  TraceSample raw;
+  raw.timeMs = millis();
+  raw.mq2 = channels.getInt(CH_GAS);
+  raw.mq7 = channels.getInt(CH_CO);
+  raw.tempCount = tempChannels < TRACE_MAX_TEMPS ? tempChannels : TRACE_MAX_TEMPS;
+  for (int j = 0; j < raw.tempCount; j++) raw.temps[j] = toFloat(channels.getRaw(CH_TEMP0 + j));
+  raw.humidity = toFloat(channels.getRaw(CH_HUMIDITY));
+  raw.pressure = toFloat(channels.getRaw(CH_PRESSURE));
+  raw.ambient = toFloat(channels.getRaw(CH_AMBIENT));
+  bt.streamSample(raw);
+#endif
+
+  // === Moving average untuk channel yang baru diisi ===
+  channels.filter();
+  sampleStamp.mark(STAGE_FILTER, micros());
+
+  // === Klasifikasi langsung setelah sampel lengkap: jalur alarm dulu ===
+  int condition = classifyCondition();
+  lastCondition = condition;
+  sampleStamp.mark(STAGE_CLASSIFY, micros());
+  if (alarmChannel.update(condition, millis())) sendAlarm(sampleUs);
+
+#ifdef TRACE_RECORD
+  // === Rekam input mentah untuk replay ===
+  if (traceFile) {
+    TraceSample sample;
+    sample.timeMs = millis();
+    sample.mq2 = channels.getInt(CH_GAS);
+    sample.mq7 = channels.getInt(CH_CO);
+    sample.tempCount = tempChannels;
+    for (int j = 0; j < tempChannels; j++) sample.temps[j] = toFloat(latestTemps()[j]);
+    sample.humidity = toFloat(channels.getRaw(CH_HUMIDITY));
+    sample.pressure = toFloat(channels.getRaw(CH_PRESSURE));
+    sample.ambient = toFloat(channels.getRaw(CH_AMBIENT));
+    traceRecorder.record(sample);
+  }
+#endif
+
+  // === Output ke log (LOG_D hilang dari binary di level default) ===
+  if (mq2.isCalibrated()) LOG_D("MQ2 LPG %.2f | CO %.2f | Smoke %.2f ppm", mq2.readLPG(), mq2.readCO(), mq2.readSmoke());
+  LOG_D("MQ2 raw %d | MQ7 CO %d", channels.getInt(CH_GAS), channels.getInt(CH_CO));
+  // for (int j = 0; j < tempChannels; j++) {
+  //   LOG_D("DS18B20 %d : %.2f °C", j, latestTemps()[j]);
+  // }
+
+  if (condition == 3) {
+    LOG_W("🔥 Kebakaran terdeteksi!");
+  } else if (condition == 2) {
+    LOG_W("🚨 Bahaya terdeteksi!");
+  } else if (condition == 1) {
+    LOG_I("⚠️ Waspada!");
+  } else {
+    LOG_D("✅ Ruangan Aman");
   }
 }
 
-void printAddress(DeviceAddress deviceAddress) {
+// === ROM code DS18B20 ke 16 digit hex (out minimal 17 byte) ===
+void formatAddress(const DeviceAddress deviceAddress, char* out) {
+  static const char hex[] = "0123456789ABCDEF";
   for (uint8_t i = 0; i < 8; i++) {
-    if (deviceAddress[i] < 16) Serial.print("0");
-    Serial.print(deviceAddress[i], HEX);
+    out[i * 2] = hex[deviceAddress[i] >> 4];
+    out[i * 2 + 1] = hex[deviceAddress[i] & 0x0F];
   }
-  Serial.println();
+  out[16] = '\0';
 }
 
 void sensorInit()
 {
-  // === Call 1D for MQ2 ===
-  if(!lpgValue.init() || !coValue.init() || !smokeValue.init())
-  {
-    Serial.println("❌ Gagal mengalokasikan memori!");
-    while (1);
+  // === Satu blok untuk semua ring moving average ===
+  // Suhu DS18B20 terbaru ada di ChannelBank (statis), arena hanya untuk ring.
+  if (!sensorArena.begin(DATA_BUFFER_SIZE, RING_COUNT)) {
+    LOG_W("⚠️ Memori kurang: %d/%d ring aktif", sensorArena.getRingChannels(), RING_COUNT);
   }
 
-  // === Call 1D for BME280 ===
-  if(!bmeHumidity.init() || !bmePressure.init())
-  {
-    Serial.println("❌ Gagal mengalokasikan memori!");
-    while (1);
-  }
-  // === Call 2D for DS18B20 ===
-  ds18b20Temp = (float**)calloc(actualSensorCount, sizeof(float*));
-  if (!ds18b20Temp) {
-    Serial.println("❌ Gagal mengalokasikan memori!");
-    while (1);
+  // Ring yang tidak kebagian tempat tetap nullptr: update() mengembalikan 0
+  lpgValue.init(sensorArena.ring(RING_LPG));
+  coValue.init(sensorArena.ring(RING_CO));
+  smokeValue.init(sensorArena.ring(RING_SMOKE));
+  bmeHumidity.init(sensorArena.ring(RING_HUMIDITY));
+  bmePressure.init(sensorArena.ring(RING_PRESSURE));
+  bmeTemperature.init(sensorArena.ring(RING_BME_TEMP));
+  channels.attachFilter(CH_HUMIDITY, &bmeHumidity);
+  channels.attachFilter(CH_PRESSURE, &bmePressure);
+  channels.attachFilter(CH_AMBIENT, &bmeTemperature);
+
+  LOG_I("🧱 Arena sensor: %u byte (%d ring) x %d sampel",
+                (unsigned)sensorArena.footprint(), sensorArena.getRingChannels(), DATA_BUFFER_SIZE);
+
+  // === Start semua driver (warm-up dihitung dari sini) ===
+  sensorScheduler.begin(millis());
+  for (size_t i = 0; i < sensorDriverCount; i++) {
+    SensorDriver* d = sensorDrivers[i];
+    if (sensorScheduler.isActive(i)) {
+      LOG_I("🔌 %s: periode %u ms, warm-up %u ms, %u channel", d->name,
+            (unsigned)d->periodMs, (unsigned)d->warmupMs, (unsigned)d->channelCount);
+    } else {
+      LOG_E("❌ %s tidak ditemukan. Check wiring!", d->name);
+    }
   }
-  for(int i = 0; i < actualSensorCount; i++)
-  {
-    ds18b20Temp[i] = (float*)calloc(DATA_BUFFER_SIZE, sizeof(float));
-    if (!ds18b20Temp[i]) {
-      Serial.printf("❌ Gagal alokasi untuk ds18b20Temp[%d]\n", i);
-      while (1);
-    }    
+
+  LOG_I("🔍 Mendeteksi %d DS18B20 sensor (maks %d)...", ds18b20Bus.getPresentCount(), DS18B20_MAX_SENSORS);
+  for (int i = 0; i < DS18B20_MAX_SENSORS; i++) {
+    if (!ds18b20Bus.isPresent(i)) continue;
+    char address[17];
+    formatAddress(ds18b20Bus.getAddress(i), address);
+    LOG_I("Sensor %d address: %s", i, address);
   }
 }
 
 void sendDataRS485()
 {
-  String data = "";
-
-  // === ID sensor ===
-  data += "SID:" + sensorID + ";";
-
-  // // === Sensor MQ2 ===
-  // data += "LPG:" + String(lpgValue.getValue(), 2) + ";";
-  // data += "CO:" + String(coValue.getValue(), 2) + ";";
-  // data += "SMK:" + String(smokeValue.getValue(), 2) + ";";
-  data += "GAS:" + String(mq2Value) + ";";
-  data += "CO:" + String(mq7Value) + ";";
-
-  // === Sensor DS18B20 ===
-  for (int i = 0; i < actualSensorCount; i++) {
-    if(ds18b20Temp[i] != NULL)
-    {
-      data += "TEMP" + String(i+1) + ":" + String(ds18b20Temp[i][dataIndex], 2) + ";";
-    }
+  // Bus dibiarkan bebas untuk ACK selama alarm belum dikonfirmasi. Frame
+  // yang ditunda digabung: hanya snapshot terbaru yang dikirim setelahnya.
+  if (alarmChannel.isPending()) {
+    framesDeferred++;
+    frameDeferred = true;
+    return;
+  }
+  frameDeferred = false;
+
+  // Nomor urut diberikan saat publish: gap di master berarti frame hilang
+  sampleStamp.seq = ++publishSeq;
+  sampleStamp.mark(STAGE_ENCODE, micros());
+
+  SampleFrame frame;
+  frame.sensorId = sensorID.c_str();
+  frame.seq = sampleStamp.seq;
+  frame.timeMs = sampleStamp.timeMs;
+  frame.gas = channels.getInt(CH_GAS);
+  frame.co = channels.getInt(CH_CO);
+  frame.temps = latestTemps();
+  frame.tempCount = tempChannels;
+  for (int i = 0; i < tempChannels; i++) tempErrors[i] = ds18b20Bus.getErrorCount(i);
+  frame.tempErrors = tempErrors;
+  frame.humidity = channels.get(CH_HUMIDITY);
+  frame.pressure = channels.get(CH_PRESSURE);
+
+  // === Batching: hanya saat kondisi normal, level naik = langsung frame tunggal ===
+  if (frameBatch.enabled() && lastCondition == CONDITION_NORMAL) {
+    frameBatch.add(makeBatchSample(frame));
+    if (frameBatch.due(millis())) flushBatch();
+    return;
   }
+  flushBatch(); // sampel yang tertunda dikirim dulu agar urutan waktu terjaga
 
-  // === BME280 ===
-  data += "HUM:" + String(bmeHumidity.getValue(), 2) + ";";
-  data += "PRS:" + String(bmePressure.getValue(), 2) + "\n"; 
+  size_t len = encodeFrame(frame, txFrame, sizeof(txFrame) - 1);
+  if (len == 0) {
+    LOG_E("❌ Frame RS485 terlalu panjang");
+    return;
+  }
+  transmitFrame(txFrame, len, sizeof(txFrame));
+}
+
+// === Kirim batch yang terkumpul (jika ada) ===
+void flushBatch()
+{
+  if (frameBatch.getCount() == 0) return;
+  int samples = frameBatch.getCount();
+  size_t len = frameBatch.encode(sensorID.c_str(), tempErrors, batchFrame, sizeof(batchFrame) - 1);
+  frameBatch.clear();
+  if (len == 0) {
+    LOG_E("❌ Frame batch terlalu panjang");
+    return;
+  }
+  batchesSent++;
+  samplesBatched += samples;
+  transmitFrame(batchFrame, len, sizeof(batchFrame)); // TR milik sampel terakhir
+}
+
+void transmitFrame(char* frame, size_t len, size_t cap)
+{
+  len = appendTrace(frame, len, cap, sampleStamp, micros());
 
   // === Kirim ke master via RS485 ===
-  rs485.send(data);
-  Serial.print("📤 Kirim RS485: ");
-  Serial.print(data);
+  rs485.send((const uint8_t*)frame, len);
+  LOG_D("📤 Kirim RS485: %.*s", (int)len, frame);
+
+  if (++framesSent % HEAP_REPORT_FRAMES == 0) reportHeap();
+}
+
+// === Kirim frame alarm prioritas ===
+// sampleUs = micros() saat sampel selesai dibaca; 0 untuk pengiriman ulang
+void sendAlarm(uint32_t sampleUs)
+{
+  size_t len = alarmChannel.encode(sensorID.c_str(), alarmFrame, sizeof(alarmFrame));
+  if (len == 0) return;
+  rs485.send((const uint8_t*)alarmFrame, len); // flush: kembali saat byte terakhir di kabel
+  if (!sampleUs) return;
+
+  uint32_t latency = micros() - sampleUs;
+  alarmChannel.recordLatency(latency);
+  if (latency > ALARM_LATENCY_TARGET_US) {
+    LOG_W("⚠️ Alarm %d di kabel %u us setelah sampel (target %u us)", alarmChannel.getLevel(), (unsigned)latency, (unsigned)ALARM_LATENCY_TARGET_US);
+  } else {
+    LOG_I("📤 Alarm %d di kabel %u us setelah sampel", alarmChannel.getLevel(), (unsigned)latency);
+  }
+}
+
+// === Pengganti delay(): tetap melayani ACK master dan retransmit alarm ===
+void serviceDelay(uint32_t ms)
+{
+  uint32_t start = millis();
+  while (millis() - start < ms) {
+    pollMasterCommands();
+    if (alarmChannel.service(millis())) sendAlarm(0);
+    if (frameDeferred && !alarmChannel.isPending()) sendDataRS485();
+    delay(1);
+  }
+}
+
+// === Bandingkan kondisi heap sekarang dengan saat boot ===
+void reportHeap()
+{
+  HeapStats now = readHeapStats();
+  LOG_I("🧮 Heap free %u (boot %u) | min %u | blok terbesar %u (boot %u) | %u frame | log drop %u",
+        (unsigned)now.freeBytes, (unsigned)heapAtBoot.freeBytes,
+        (unsigned)now.minFreeBytes, (unsigned)now.largestBlock,
+        (unsigned)heapAtBoot.largestBlock, (unsigned)framesSent, (unsigned)logDropped());
+  LOG_I("🚨 Alarm %u kirim | %u ACK | %u menyerah | latensi terburuk %u us | %u frame ditunda ke snapshot",
+        (unsigned)alarmChannel.getSent(), (unsigned)alarmChannel.getAcked(), (unsigned)alarmChannel.getGiveUps(),
+        (unsigned)alarmChannel.getWorstLatencyUs(), (unsigned)framesDeferred);
+  LOG_I("🧱 Batch N=%d / %u ms | %u batch | %u sampel",
+        frameBatch.getSize(), (unsigned)frameBatch.getWindow(), (unsigned)batchesSent, (unsigned)samplesBatched);
+#ifdef BT_STREAM
+  LOG_I("📡 Stream %u batch terkirim | %u batch dibuang", (unsigned)bt.getStreamSent(), (unsigned)bt.getStreamDropped());
+#endif
+  reportSensorCost();
+}
+
+// === Biaya CPU per driver sensor sejak laporan terakhir ===
+void reportSensorCost()
+{
+  for (size_t i = 0; i < sensorDriverCount; i++) {
+    if (!sensorScheduler.isActive(i)) continue;
+    const SensorDriverStats& st = sensorScheduler.getStats(i);
+    LOG_I("⏱️ %s: %u poll (%u sampel) | rata2 %u us | maks %u us | telat maks %u ms | %u overrun",
+          sensorDrivers[i]->name, (unsigned)st.polls, (unsigned)st.samples, (unsigned)sensorScheduler.avgCostUs(i),
+          (unsigned)st.maxUs, (unsigned)st.maxLateMs, (unsigned)st.overruns);
+  }
+  if (bmeDriver.getFailures()) LOG_W("⚠️ Gagal membaca BME280 %u kali", (unsigned)bmeDriver.getFailures());
+  sensorScheduler.resetStats();
 }
 
 bool idCheck()
@@ -287,39 +569,113 @@ void setNewID()
   sensorID = String(randPart, HEX) + String(timePart, HEX);
   memory.write<uint32_t>(MAGIC_ADDR, MAGIC_NUMBER);
   memory.writeString(4, sensorID);
-  Serial.printf("ID baru: %s\n", sensorID);
+  LOG_I("ID baru: %s", sensorID.c_str());
 }
 
 int classifyCondition() {
-  float avgTemp = avgArray(ds18b20Temp, actualSensorCount);
-  int score = 0;
-  if (avgTemp > 50) score++;
-  if (bmeHumidity.getValue() < 30) score++;
-  if (mq2Value > 400) score++;
-  if (mq7Value > 20) score+= mq7Value/20;
-  for(int i = 0; i < actualSensorCount; i++) 
-  {
-    if(abs(ds18b20Temp[i][dataIndex]-avgTemp) > 5)
-    {
-      score++;
-      break;
+  return classifyReading(latestTemps(), tempChannels, channels.get(CH_AMBIENT), channels.get(CH_HUMIDITY),
+                         channels.getInt(CH_GAS), channels.getInt(CH_CO));
+}
+
+// === Suhu terbaru semua DS18B20 (tempChannels sample_t berdampingan) ===
+const sample_t* latestTemps()
+{
+  return channels.row(CH_TEMP0);
+}
+
+// === Kumpulkan byte RS485 per baris lalu dispatch tanpa alokasi ===
+void pollMasterCommands()
+{
+  while (rs485.available()) {
+    int c = rs485.readByte();
+    if (c < 0) break;
+    if (c == '\n') {
+      uint32_t rxMs = millis(); // t1 untuk SYNC
+      MasterCommand cmd = { false, false, false, 0, -1, -1, false, 0 };
+      dispatchKeyValues(rxLine, rxLen, masterCommands, masterCommandCount, &cmd);
+      if (cmd.addressed && cmd.hasAck && alarmChannel.acknowledge((uint16_t)cmd.ackSeq)) {
+        LOG_I("✅ Alarm %u di-ACK master", (unsigned)cmd.ackSeq);
+      }
+      if (cmd.addressed && (cmd.batchSize >= 0 || cmd.batchWindow >= 0)) {
+        if (cmd.batchSize >= 0) frameBatch.setSize(cmd.batchSize);
+        if (cmd.batchWindow >= 0) frameBatch.setWindow(cmd.batchWindow);
+        LOG_I("🧱 Batch %d sampel / %u ms", frameBatch.getSize(), (unsigned)frameBatch.getWindow());
+      }
+      if (cmd.addressed && !cmd.broadcast && cmd.hasSync) {
+        char syncFrame[SYNC_FRAME_MAX];
+        size_t len = encodeSyncReply(sensorID.c_str(), cmd.syncT0, rxMs, millis(), syncFrame, sizeof(syncFrame));
+        if (len) rs485.send((const uint8_t*)syncFrame, len);
+      }
+      rxLen = 0;
+    } else if (rxLen < RX_LINE_MAX) {
+      rxLine[rxLen++] = (char)c;
+    } else {
+      rxLen = 0; // baris terlalu panjang, buang
     }
   }
+}
 
-  if (score >= 4) return 3; // Kebakaran
-  else if (score == 3) return 2; // Bahaya
-  else if (score == 2) return 1; // Waspada
-  else return 0; // Normal
+void onCmdACK(int index, const TokenSpan& value, void* ctx)
+{
+  MasterCommand* cmd = (MasterCommand*)ctx;
+  cmd->hasAck = spanToLong(value, cmd->ackSeq);
 }
 
-float avgArray(float** arr, int size)
+void onCmdBN(int index, const TokenSpan& value, void* ctx)
 {
-  float sum = 0;
-  for(int i = 0; i < size; i++)
-  {
-    sum += arr[i][dataIndex];
+  MasterCommand* cmd = (MasterCommand*)ctx;
+  long n;
+  if (spanToLong(value, n) && n >= 1) cmd->batchSize = n;
+}
+
+void onCmdBW(int index, const TokenSpan& value, void* ctx)
+{
+  MasterCommand* cmd = (MasterCommand*)ctx;
+  long ms;
+  if (spanToLong(value, ms) && ms >= 0) cmd->batchWindow = ms;
+}
+
+void onCmdSID(int index, const TokenSpan& value, void* ctx)
+{
+  MasterCommand* cmd = (MasterCommand*)ctx;
+  cmd->broadcast = spanEquals(value, "*");
+  cmd->addressed = cmd->broadcast || spanEquals(value, sensorID.c_str());
+}
+
+void onCmdSYNC(int index, const TokenSpan& value, void* ctx)
+{
+  MasterCommand* cmd = (MasterCommand*)ctx;
+  cmd->hasSync = spanToUnsigned(value, cmd->syncT0);
+}
+
+void traceInit()
+{
+#ifdef TRACE_RECORD
+  if (!LittleFS.begin(true)) {
+    LOG_E("❌ LittleFS gagal, trace tidak direkam");
+    return;
+  }
+  traceFile = LittleFS.open(TRACE_FILE, FILE_WRITE);
+  if (!traceFile) {
+    LOG_E("❌ Gagal membuka file trace");
+    return;
+  }
+  traceRecorder.begin();
+  LOG_I("🎞️ Trace direkam ke %s", TRACE_FILE);
+#endif
+}
+
+void adcCalInit()
+{
+  // Prioritas: kurva per-device di EEPROM > eFuse > linear
+  AdcCalCurve curve = memory.read<AdcCalCurve>(ADC_CAL_ADDR);
+  if (adcCal.buildFromCurve(curve)) {
+    LOG_I("🧮 ADC kalibrasi: kurva EEPROM (%d titik)", curve.count);
+  } else if (adcCal.buildFromEfuse()) {
+    LOG_I("🧮 ADC kalibrasi: eFuse");
+  } else {
+    LOG_W("⚠️ ADC tanpa kalibrasi, asumsi linear");
   }
-  return sum / size;
 }
 
 void buzzerAlert() {
@@ -0,0 +1,304 @@
+// === Replay trace sensor di host ===
+// Menjalankan rekaman trace (lihat trace_format.h) melalui filter, klasifikasi
+// dan encoder frame RS485 yang sama dengan firmware, jauh lebih cepat dari real time.
+//
+// Build & jalankan:
+//   pio run -e replay
+//   .pio/build/replay/program trace.bin [--event <ms>] [--level <n>] [--frames]
+//
+//   --event <ms>  waktu (timeMs trace) kejadian sebenarnya dimulai. Alarm sebelum
+//                 waktu ini dihitung false alarm; tanpa opsi ini trace dianggap
+//                 bersih sehingga semua alarm adalah false alarm.
+//   --level <n>   level kondisi yang dianggap alarm (default 2 = Bahaya)
+//   --frames      cetak setiap frame yang akan dikirim
+//   --soak <n>    ulangi trace n kali dan laporkan alokasi heap selama pemrosesan
+//   --stream <B/s> kirim sampel mentah lewat StreamBatcher ke serial palsu
+//                 dengan throughput B/s, lalu decode ulang dan cek seq/CRC
+//
+// Laporan selalu memuat "output digest": FNV-1a 64-bit atas semua frame dan
+// level kondisi. Simpan digest sebagai referensi lalu bandingkan antar commit
+// atau antar build (float vs -D FIXED_POINT_BUILD) untuk cek bit-exactness.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <vector>
+#include <SignalProcessing.h>
+#include "sensor_config.h"
+#include "sample_type.h"
+#include "sensor_channels.h"
+#include "condition.h"
+#include "frame_encoder.h"
+#include "trace_format.h"
+#include "heap_stats.h"
+#include "stream_batch.h"
+#include "alarm_channel.h"
+
+#define RS485_BAUD 9600
+#define BITS_PER_BYTE 10 // 8N1
+#define HEAP_SAMPLE_FRAMES 1000
+
+// === Hitung alokasi heap (glibc) ===
+extern "C" void* __libc_malloc(size_t);
+extern "C" void* __libc_calloc(size_t, size_t);
+extern "C" void* __libc_realloc(void*, size_t);
+static unsigned long heapAllocations = 0;
+extern "C" void* malloc(size_t n) { heapAllocations++; return __libc_malloc(n); }
+extern "C" void* calloc(size_t n, size_t size) { heapAllocations++; return __libc_calloc(n, size); }
+extern "C" void* realloc(void* p, size_t n) { heapAllocations++; return __libc_realloc(p, n); }
+
+#define STREAM_BATCH_SAMPLES 16
+#define REPLAY_SENSOR_ID "0123456789abcdef" // panjang SID terpanjang dari setNewID()
+
+// === Serial palsu dengan throughput terbatas (link SPP) ===
+// write() hanya menerima sebanyak budget byte yang terkumpul sejak panggilan
+// sebelumnya; sisanya harus dicoba lagi, persis seperti link yang macet.
+struct FakeSerialSink {
+  double bytesPerSec;
+  double budget;
+  std::vector<uint8_t> received;
+
+  FakeSerialSink(double rate) : bytesPerSec(rate), budget(0) {}
+
+  void advance(uint32_t ms) {
+    budget += bytesPerSec * ms / 1000.0;
+    if (budget > STREAM_BATCH_MAX_BYTES) budget = STREAM_BATCH_MAX_BYTES; // buffer TX terbatas
+  }
+
+  size_t write(const uint8_t* data, size_t len) {
+    size_t n = len < (size_t)budget ? len : (size_t)budget;
+    received.insert(received.end(), data, data + n);
+    budget -= n;
+    return n;
+  }
+};
+
+static bool readFile(const char* path, std::vector<uint8_t>& out)
+{
+  FILE* f = fopen(path, "rb");
+  if (!f) return false;
+  uint8_t chunk[4096];
+  size_t n;
+  while ((n = fread(chunk, 1, sizeof(chunk), f)) > 0) out.insert(out.end(), chunk, chunk + n);
+  fclose(f);
+  return true;
+}
+
+int main(int argc, char** argv)
+{
+  if (argc < 2) {
+    fprintf(stderr, "usage: %s <trace.bin> [--event <ms>] [--level <n>] [--frames] [--soak <n>] [--stream <B/s>]\n", argv[0]);
+    return 2;
+  }
+
+  long eventMs = -1;
+  int alarmLevel = CONDITION_BAHAYA;
+  bool printFrames = false;
+  int soakPasses = 1;
+  double streamRate = 0;
+  for (int i = 2; i < argc; i++) {
+    if (!strcmp(argv[i], "--event") && i + 1 < argc) eventMs = atol(argv[++i]);
+    else if (!strcmp(argv[i], "--level") && i + 1 < argc) alarmLevel = atoi(argv[++i]);
+    else if (!strcmp(argv[i], "--frames")) printFrames = true;
+    else if (!strcmp(argv[i], "--soak") && i + 1 < argc) soakPasses = atoi(argv[++i]);
+    else if (!strcmp(argv[i], "--stream") && i + 1 < argc) streamRate = atof(argv[++i]);
+    else {
+      fprintf(stderr, "unknown option: %s\n", argv[i]);
+      return 2;
+    }
+  }
+
+  std::vector<uint8_t> data;
+  if (!readFile(argv[1], data)) {
+    fprintf(stderr, "cannot open %s\n", argv[1]);
+    return 1;
+  }
+  int version = decodeTraceHeader(data.data(), data.size());
+  if (!version) {
+    fprintf(stderr, "%s: bukan file trace (v1..v%d)\n", argv[1], TRACE_VERSION);
+    return 1;
+  }
+
+  // Decode dulu agar waktu CPU hanya mengukur pemrosesan
+  std::vector<TraceSample> samples;
+  size_t pos = TRACE_HEADER_SIZE;
+  while (pos < data.size()) {
+    TraceSample s;
+    size_t used = decodeTraceSample(data.data() + pos, data.size() - pos, s, version);
+    if (used == 0) {
+      fprintf(stderr, "record rusak/terpotong di offset %zu, berhenti\n", pos);
+      break;
+    }
+    samples.push_back(s);
+    pos += used;
+  }
+  if (samples.empty()) {
+    fprintf(stderr, "trace kosong\n");
+    return 1;
+  }
+
+  // === Pipeline yang sama dengan readData() / sendDataRS485() ===
+  sampleAverage bmeHumidity(DATA_BUFFER_SIZE);
+  sampleAverage bmePressure(DATA_BUFFER_SIZE);
+  sampleAverage bmeTemperature(DATA_BUFFER_SIZE);
+  bmeHumidity.init();
+  bmePressure.init();
+  bmeTemperature.init();
+  // BME280 lewat ChannelBank seperti readData(): tidak valid sampai terbaca
+  ChannelBank channels;
+  channels.attachFilter(CH_HUMIDITY, &bmeHumidity);
+  channels.attachFilter(CH_PRESSURE, &bmePressure);
+  channels.attachFilter(CH_AMBIENT, &bmeTemperature);
+
+  unsigned long frames = 0, wireBytes = 0, falseAlarms = 0, alarms = 0;
+  long detectionLatency = -1;
+  bool inAlarm = false;
+  static char frame[FRAME_MAX_LEN];
+  sample_t temps[TRACE_MAX_TEMPS];
+  uint64_t digest = 1469598103934665603ULL; // FNV-1a 64-bit
+  if (soakPasses < 1) soakPasses = 1;
+  static StreamBatcher batcher;
+  FakeSerialSink streamSink(streamRate);
+  batcher.begin(STREAM_BATCH_SAMPLES);
+  AlarmChannel alarmPath;
+  char alarmFrame[ALARM_FRAME_MAX];
+  double alarmWorstMs = 0;
+
+  HeapStats heapBefore = readHeapStats();
+  size_t heapMinFree = heapBefore.freeBytes;
+  unsigned long allocBefore = heapAllocations;
+
+  clock_t start = clock();
+  for (int pass = 0; pass < soakPasses; pass++)
+  for (size_t i = 0; i < samples.size(); i++) {
+    const TraceSample& s = samples[i];
+    for (int j = 0; j < s.tempCount; j++) temps[j] = sample_t(s.temps[j]);
+    // Trace tanpa BME280 membawa NAN: channel tetap tidak valid seperti di device
+    channels.set(CH_HUMIDITY, sample_t(s.humidity), s.timeMs);
+    channels.set(CH_PRESSURE, sample_t(s.pressure), s.timeMs);
+    channels.set(CH_AMBIENT, sample_t(s.ambient), s.timeMs);
+    channels.filter();
+
+    int condition = classifyReading(temps, s.tempCount, channels.get(CH_AMBIENT), channels.get(CH_HUMIDITY),
+                                    s.mq2, s.mq7);
+    bool alarm = condition >= alarmLevel;
+    if (pass == 0) { // statistik alarm hanya dari pass pertama
+      if (alarm && !inAlarm) {
+        alarms++;
+        if (eventMs < 0 || (long)s.timeMs < eventMs) falseAlarms++;
+      }
+      if (alarm && eventMs >= 0 && (long)s.timeMs >= eventMs && detectionLatency < 0) {
+        detectionLatency = (long)s.timeMs - eventMs;
+      }
+      inAlarm = alarm;
+      digest = (digest ^ (uint8_t)condition) * 1099511628211ULL;
+
+      // Jalur alarm: latensi = proses (host, diabaikan) + frame alarm di kabel.
+      // Master simulasi langsung ACK sehingga frame rutin tidak ditunda.
+      if (alarmPath.update(condition, s.timeMs)) {
+        size_t len = alarmPath.encode(REPLAY_SENSOR_ID, alarmFrame, sizeof(alarmFrame));
+        double wireMs = len * BITS_PER_BYTE * 1000.0 / RS485_BAUD;
+        if (wireMs > alarmWorstMs) alarmWorstMs = wireMs;
+        alarmPath.acknowledge(alarmPath.getSeq());
+      }
+
+      if (streamRate > 0) {
+        if (i > 0) streamSink.advance(s.timeMs - samples[i - 1].timeMs);
+        batcher.push(s);
+        batcher.pump(streamSink);
+      }
+    }
+
+    // Firmware mengirim satu frame setiap DATA_READ_PER_INTERVAL sampel
+    if ((i + 1) % DATA_READ_PER_INTERVAL == 0) {
+      SampleFrame f = { "replay", (uint32_t)frames + 1, s.timeMs, s.mq2, s.mq7, temps, s.tempCount, NULL,
+                        channels.get(CH_HUMIDITY), channels.get(CH_PRESSURE) };
+      size_t len = encodeFrame(f, frame, sizeof(frame));
+      if (pass == 0) {
+        for (size_t k = 0; k < len; k++) digest = (digest ^ (uint8_t)frame[k]) * 1099511628211ULL;
+      }
+      wireBytes += len;
+      frames++;
+      if (printFrames) fwrite(frame, 1, len, stdout);
+      if (frames % HEAP_SAMPLE_FRAMES == 0) {
+        size_t freeNow = readHeapStats().freeBytes;
+        if (freeNow < heapMinFree) heapMinFree = freeNow;
+      }
+    }
+  }
+  double cpuSec = (double)(clock() - start) / CLOCKS_PER_SEC;
+  unsigned long allocDuring = heapAllocations - allocBefore;
+  HeapStats heapAfter = readHeapStats();
+
+  // === Decode ulang stream seperti tool di laptop ===
+  unsigned long streamBatches = 0, streamSamples = 0, streamGaps = 0, streamResync = 0;
+  if (streamRate > 0) {
+    const std::vector<uint8_t>& rx = streamSink.received;
+    size_t p = 0;
+    int lastSeq = -1;
+    while (p < rx.size()) {
+      uint16_t seq;
+      int count;
+      const uint8_t* payload;
+      size_t payloadLen;
+      size_t used = decodeStreamBatch(rx.data() + p, rx.size() - p, seq, count, payload, payloadLen);
+      if (!used) { // batch terakhir terpotong atau byte sampah: cari sync berikutnya
+        p++;
+        streamResync++;
+        continue;
+      }
+      if (lastSeq >= 0) streamGaps += (uint16_t)(seq - lastSeq - 1);
+      lastSeq = seq;
+      size_t q = 0;
+      for (int k = 0; k < count; k++) {
+        TraceSample rs;
+        size_t n = decodeTraceSample(payload + q, payloadLen - q, rs);
+        if (!n) break;
+        q += n;
+        streamSamples++;
+      }
+      streamBatches++;
+      p += used;
+    }
+  }
+
+  double simHours = soakPasses * (samples.back().timeMs - samples.front().timeMs) / 3600000.0;
+  printf("==== Replay ====\n");
+#ifdef FIXED_POINT_BUILD
+  printf("sample type        : q16.16\n");
+#else
+  printf("sample type        : float\n");
+#endif
+  printf("samples            : %zu x %d pass\n", samples.size(), soakPasses);
+  printf("simulated time     : %.3f h\n", simHours);
+  printf("alarm level        : >= %d\n", alarmLevel);
+  printf("alarms             : %lu\n", alarms);
+  printf("false alarms       : %lu\n", falseAlarms);
+  if (eventMs >= 0) {
+    if (detectionLatency >= 0) printf("detection latency  : %ld ms\n", detectionLatency);
+    else printf("detection latency  : tidak terdeteksi\n");
+  }
+  printf("alarm frames       : %u (ambang level %d)\n", alarmPath.getSent(), ALARM_THRESHOLD);
+  if (alarmPath.getSent()) {
+    printf("alarm on wire      : %.1f ms terburuk @ %d baud (target < 50 ms)\n", alarmWorstMs, RS485_BAUD);
+  }
+  printf("frames             : %lu\n", frames);
+  printf("output digest      : %016llx\n", (unsigned long long)digest);
+  printf("bytes on wire      : %lu (%.1f s @ %d baud)\n", wireBytes,
+         (double)wireBytes * BITS_PER_BYTE / RS485_BAUD, RS485_BAUD);
+  if (streamRate > 0) {
+    printf("stream             : %.0f B/s, %d sampel/batch\n", streamRate, STREAM_BATCH_SAMPLES);
+    printf("stream batches     : %u terkirim, %u dibuang (backpressure)\n", batcher.getSent(), batcher.getDropped());
+    printf("stream decoded     : %lu batch, %lu sampel, %lu seq hilang, %lu byte resync\n",
+           streamBatches, streamSamples, streamGaps, streamResync);
+  }
+  printf("cpu time           : %.3f ms\n", cpuSec * 1000.0);
+  printf("heap allocations   : %lu selama pemrosesan\n", allocDuring);
+  printf("heap free          : %zu -> %zu (min %zu)\n", heapBefore.freeBytes, heapAfter.freeBytes, heapMinFree);
+  if (simHours > 0) {
+    printf("cpu per sim hour   : %.3f ms\n", cpuSec * 1000.0 / simHours);
+    printf("speedup            : %.0fx\n", cpuSec > 0 ? simHours * 3600.0 / cpuSec : 0.0);
+  }
+  return 0;
+}
@@ -0,0 +1,206 @@
+// === Simulasi scheduler driver sensor di host ===
+// Menjalankan SensorScheduler (sensor_driver.h) dengan driver palsu
+// (sensor_fakes.h) yang periode, warm-up dan channelnya sama dengan driver
+// asli, di atas jam us palsu. Jadwal loop() adalah SlaveLoop (slave_loop.h)
+// yang sama dengan firmware; hanya langkahnya yang disimulasikan: readData()
+// = run() scheduler + filter, frame RS485 memblokir selama airtime frame
+// (Serial.flush(), panjang dari encodeFrame() sungguhan), tidur = majukan jam.
+// MQ7 memakai state machine heater asli (MQ7Cycle.h): satu nilai per siklus.
+//
+// Build & jalankan:
+//   pio run -e schedsim
+//   .pio/build/schedsim/program [--seconds <s>] [--fail <n>] [--no-bme]
+//                               [--ds-read <us>] [--oversampling]
+//
+//   --seconds <s>    lama simulasi (default 600)
+//   --fail <n>       DS18B20 dan BME280 gagal setiap pembacaan ke-n (default 0 = tidak)
+//   --no-bme         BME280 tidak terpasang (begin() gagal)
+//   --ds-read <us>   biaya baca scratchpad semua DS18B20 (default 24000)
+//   --oversampling   biaya MQ2/MQ7 seperti ADC_OVERSAMPLING (baca ring ADC)
+//
+// Laporan per driver: poll, pembacaan, biaya rata-rata/maks, keterlambatan
+// maksimum dan overrun, ditambah cek warm-up, jumlah pembacaan per periode
+// (MQ7: per siklus heater) dan siklus MQ7 yang terlewat.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "sensor_config.h"
+#include "sensor_channels.h"
+#include "sensor_fakes.h"
+#include "slave_loop.h"
+#include "frame_encoder.h"
+
+#define RS485_BAUD 9600
+#define BITS_PER_BYTE 10 // 8N1
+#define SIM_FRAME_ENCODE_US 300   // encodeFrame() + trace latensi
+#define SIM_PROCESS_US 250        // filter + klasifikasi per readData() yang menghasilkan
+
+// Perkiraan biaya poll per driver (us); bandingkan dengan reportSensorCost() di board
+#define SIM_MQ2_US 60             // analogRead()
+#define SIM_MQ2_OVERSAMPLING_US 15 // ambil sampel CIC dari ring
+#define SIM_MQ7_UPDATE_US 8       // mq7HeaterCycle::update() + ledcWrite saat ganti fase
+#define SIM_MQ7_US 70             // latch: analogRead() + Rs -> ppm
+#define SIM_MQ7_OVERSAMPLING_US 25 // latch dari ring CIC
+#define SIM_DS_START_US 1200      // reset + skip ROM + convert T
+#define SIM_DS_CONV_MS 750        // 12-bit
+#define SIM_BME_START_US 180      // tulis ctrl_meas (forced)
+#define SIM_BME_MEAS_MS 10        // osrs x1
+#define SIM_BME_FETCH_US 450      // burst read 8 byte + kompensasi
+
+enum { DRV_MQ2, DRV_MQ7, DRV_DS18B20, DRV_BME280 };
+
+// === Keadaan simulasi, dipakai langkah-langkah SlaveLoop ===
+static SensorScheduler* scheduler;
+static ChannelBank channels;
+static uint32_t seq = 0;
+static uint64_t frameUs = 0, sleepUs = 0;
+static unsigned long frames = 0, frameBytes = 0;
+
+static uint32_t simClockMs() { return fakeClockUs() / 1000; }
+
+// readData(): poll driver jatuh tempo, filter + klasifikasi jika ada hasil
+static void simReadData()
+{
+  if (scheduler->run(simClockMs(), channels)) {
+    channels.filter();
+    fakeClockUs() += SIM_PROCESS_US;
+  }
+}
+
+// sendDataRS485(): encode frame sungguhan, blok selama airtime
+static void simSendFrame()
+{
+  char frame[FRAME_MAX_LEN];
+  FrameData f = { "a1b2c3d4e5f60001", ++seq, simClockMs(), channels.getInt(CH_GAS), channels.getInt(CH_CO),
+                  channels.row(CH_TEMP0), DS18B20_MAX_SENSORS, NULL,
+                  channels.get(CH_HUMIDITY), channels.get(CH_PRESSURE) };
+  size_t len = encodeFrame(f, frame, sizeof(frame));
+  uint32_t cost = SIM_FRAME_ENCODE_US + (uint32_t)((uint64_t)len * BITS_PER_BYTE * 1000000 / RS485_BAUD);
+  fakeClockUs() += cost;
+  frameUs += cost;
+  frames++;
+  frameBytes += len;
+}
+
+// serviceDelay(): jam maju, CPU idle
+static void simSleep(uint32_t ms)
+{
+  fakeClockUs() += ms * 1000;
+  sleepUs += (uint64_t)ms * 1000;
+}
+
+int main(int argc, char** argv)
+{
+  uint32_t seconds = 600;
+  uint32_t failEvery = 0;
+  bool bme = true;
+  uint32_t dsReadUs = 24000;
+  bool oversampling = false;
+
+  for (int i = 1; i < argc; i++) {
+    const char* arg = argv[i];
+    const char* val = i + 1 < argc ? argv[i + 1] : NULL;
+    if (strcmp(arg, "--no-bme") == 0) { bme = false; continue; }
+    if (strcmp(arg, "--oversampling") == 0) { oversampling = true; continue; }
+    if (!val) {
+      fprintf(stderr, "Opsi tidak dikenal: %s\n", arg);
+      return 1;
+    }
+    if (strcmp(arg, "--seconds") == 0) seconds = strtoul(val, NULL, 10);
+    else if (strcmp(arg, "--fail") == 0) failEvery = strtoul(val, NULL, 10);
+    else if (strcmp(arg, "--ds-read") == 0) dsReadUs = strtoul(val, NULL, 10);
+    else {
+      fprintf(stderr, "Opsi tidak dikenal: %s\n", arg);
+      return 1;
+    }
+    i++;
+  }
+  if (seconds < 1 || seconds > 4000) { // jam us palsu 32-bit
+    fprintf(stderr, "Parameter tidak valid\n");
+    return 1;
+  }
+
+  FakeSensorDriver mq2("MQ2", MQ2_PERIOD_MS, MQ2_WARMUP_MS, CH_GAS, 1,
+                       oversampling ? SIM_MQ2_OVERSAMPLING_US : SIM_MQ2_US);
+  FakeMQ7Driver mq7(MQ7_PERIOD_MS, MQ7_WARMUP_MS, CH_CO, SIM_MQ7_UPDATE_US,
+                    oversampling ? SIM_MQ7_OVERSAMPLING_US : SIM_MQ7_US);
+  FakeSensorDriver ds("DS18B20", DS18B20_PERIOD_MS, 0, CH_TEMP0, DS18B20_MAX_SENSORS,
+                      dsReadUs, SIM_DS_CONV_MS, SIM_DS_START_US);
+  FakeSensorDriver bmeDriver("BME280", BME280_PERIOD_MS, 0, CH_HUMIDITY, 3,
+                             SIM_BME_FETCH_US, SIM_BME_MEAS_MS, SIM_BME_START_US);
+  mq2.setValue(300, 0.5f);
+  mq7.setValue(3, 0.5f);
+  ds.setValue(25.0f, 0.01f);
+  bmeDriver.setValue(55.0f, 0.01f);
+  ds.setFailEvery(failEvery);
+  bmeDriver.setFailEvery(failEvery);
+  bmeDriver.setPresent(bme);
+
+  // Urutan sama dengan registry sensorDrivers[] di main.cpp (DRV_*)
+  SensorDriver* const drivers[] = { &mq2, &mq7, &ds, &bmeDriver };
+  FakeSensorDriver* const fakes[] = { &mq2, &mq7, &ds, &bmeDriver };
+  const size_t driverCount = sizeof(drivers) / sizeof(drivers[0]);
+  SensorScheduler sched(drivers, driverCount, fakeMicros);
+  scheduler = &sched;
+
+  // Master dan buzzer tidak disimulasikan
+  const SlaveLoopSteps steps = { NULL, simReadData, NULL, simSendFrame, simSleep };
+  SlaveLoop slaveLoop(sched, simClockMs, steps);
+
+  fakeClockUs() = 0;
+  int active = sched.begin(0);
+
+  const uint64_t endUs = (uint64_t)seconds * 1000000;
+  unsigned long loops = 0;
+  while (fakeClockUs() < endUs) {
+    slaveLoop.run();
+    loops++;
+  }
+  const uint64_t elapsedUs = fakeClockUs();
+  const uint64_t busyUs = elapsedUs - sleepUs;
+  const uint32_t elapsedMs = (uint32_t)(elapsedUs / 1000);
+
+  printf("==== Simulasi scheduler: %u s, %d/%u driver aktif, gagal tiap %u baca ====\n",
+         (unsigned)seconds, active, (unsigned)driverCount, (unsigned)failEvery);
+  printf("loop %lu (%.1f /s), CPU sibuk %.2f %% (frame RS485 %.2f %%)\n",
+         loops, loops / (double)seconds, busyUs * 100.0 / elapsedUs, frameUs * 100.0 / elapsedUs);
+  printf("frame %lu, rata-rata %lu byte\n", frames, frames ? frameBytes / frames : 0);
+  printf("%-8s %6s %8s %7s %9s %8s %9s %7s %7s %9s\n",
+         "driver", "period", "poll", "baca", "rata us", "maks us", "telat ms", "overrun", "gagal", "warmup");
+
+  bool ok = true;
+  for (size_t i = 0; i < driverCount; i++) {
+    FakeSensorDriver& d = *fakes[i];
+    if (!sched.isActive(i)) {
+      printf("%-8s %6u  tidak aktif\n", d.name, (unsigned)d.periodMs);
+      if (d.wasPolled()) ok = false;
+      continue;
+    }
+    const SensorDriverStats& st = sched.getStats(i);
+    uint32_t firstPoll = d.firstPollDelayMs();
+    bool warmupOk = d.wasPolled() && firstPoll >= d.warmupMs;
+    if (!warmupOk) ok = false;
+    printf("%-8s %6u %8u %7u %9u %8u %9u %7u %7u %5u ms%s\n",
+           d.name, (unsigned)d.periodMs, (unsigned)st.polls, (unsigned)st.samples,
+           (unsigned)sched.avgCostUs(i), (unsigned)st.maxUs, (unsigned)st.maxLateMs,
+           (unsigned)st.overruns, (unsigned)d.getFailures(), (unsigned)firstPoll, warmupOk ? "" : " !");
+
+    // Periode efektif: pembacaan (termasuk gagal) per detik aktif
+    uint32_t expected = d.expectedReads(elapsedMs);
+    uint32_t reads = st.samples + d.getFailures();
+    if (reads + 1 < expected) {
+      printf("  ⚠️ %s: %u baca, diharapkan %u\n", d.name, (unsigned)reads, (unsigned)expected);
+      ok = false;
+    }
+  }
+  // MQ7: tepat satu nilai per siklus heater, tanpa jendela sampel terlewat
+  uint32_t mq7Reads = sched.getStats(DRV_MQ7).samples;
+  uint32_t mq7Expected = mq7.expectedReads(elapsedMs);
+  printf("MQ7 siklus heater: %u nilai, diharapkan %u, jendela terlewat %u\n",
+         (unsigned)mq7Reads, (unsigned)mq7Expected, (unsigned)mq7.getMissed());
+  if (mq7Reads != mq7Expected || mq7.getMissed()) ok = false;
+
+  printf("%s\n", ok ? "✅ jadwal dan warm-up sesuai" : "❌ jadwal atau warm-up menyimpang");
+  return ok ? 0 : 1;
+}
@@ -0,0 +1,106 @@
+// === Uji CIC oversampling ADC (AdcOversampler + cicDecimator) di host ===
+// Sampel mentah dari SyntheticAdcDriver (adc_mock.h); ideal() dipakai sebagai
+// acuan tanpa noise/kuantisasi. Output 16-bit = input 12-bit * 16.
+// Jalankan: pio test -e native_test
+
+#include <unity.h>
+#include <math.h>
+#include "adc_mock.h"
+
+#define TEST_CHANNEL 6
+#define TEST_RATE_HZ 10000
+
+static const uint8_t hwChannels[] = { TEST_CHANNEL };
+
+void setUp(void) {}
+void tearDown(void) {}
+
+// Satu sampel mentah dari driver ke oversampler; return true jika ada output
+static bool step(SyntheticAdcDriver& driver, AdcOversampler& adc, uint16_t& out)
+{
+  AdcSample s;
+  driver.read(&s, 1, 0);
+  adc.process(&s, 1);
+  return adc.latest(0, out);
+}
+
+void test_dc_gain_after_warmup(void)
+{
+  SyntheticAdcDriver driver;
+  AdcOversampler adc(driver);
+  TEST_ASSERT_TRUE(adc.begin(hwChannels, 1, TEST_RATE_HZ, 2, 8));
+  SyntheticChannel dc = { 1500, 0, 0, 0 };
+  driver.setSignal(0, dc);
+
+  uint16_t out = 0;
+  // Dua output pertama (order 2) masih warm-up: belum ada pembacaan valid
+  for (int i = 0; i < 2 * 256; i++) TEST_ASSERT_FALSE(step(driver, adc, out));
+  for (int i = 0; i < 256; i++) step(driver, adc, out);
+  TEST_ASSERT_TRUE(adc.latest(0, out));
+  TEST_ASSERT_EQUAL_UINT32(24000, out); // 1500 * 16, bukan ~12000
+}
+
+// Tanpa overshoot dan sudah di nilai akhir paling lambat order output setelah step
+void test_step_response_bounded(void)
+{
+  const int order = 3, r = 16;
+  SyntheticAdcDriver driver;
+  AdcOversampler live(driver);
+  live.begin(hwChannels, 1, TEST_RATE_HZ, order, 4);
+
+  uint16_t out = 0;
+  AdcSample s = { TEST_CHANNEL, 1000 };
+  for (int i = 0; i < 10 * r; i++) live.process(&s, 1);
+  TEST_ASSERT_TRUE(live.latest(0, out));
+  TEST_ASSERT_EQUAL_UINT32(16000, out);
+
+  s.value = 3000;
+  for (int k = 1; k <= 6; k++) {
+    for (int i = 0; i < r; i++) live.process(&s, 1);
+    TEST_ASSERT_TRUE(live.latest(0, out));
+    TEST_ASSERT_TRUE(out >= 16000 && out <= 48000);
+    if (k >= order) TEST_ASSERT_EQUAL_UINT32(48000, out);
+  }
+}
+
+// RMS galat output terhadap ideal() untuk satu rasio decimation
+static float noiseRms(uint8_t log2Decimation)
+{
+  SyntheticAdcDriver driver;
+  AdcOversampler adc(driver);
+  adc.begin(hwChannels, 1, TEST_RATE_HZ, 2, log2Decimation);
+  SyntheticChannel noisy = { 1500.3f, 0, 0, 40 };
+  driver.setSignal(0, noisy);
+
+  const uint32_t r = 1UL << log2Decimation;
+  double sum = 0;
+  int n = 0;
+  uint16_t out;
+  for (uint64_t i = 0; n < 200; i++) {
+    AdcSample s;
+    driver.read(&s, 1, 0);
+    adc.process(&s, 1);
+    if ((i + 1) % r || !adc.latest(0, out)) continue;
+    float err = out / 16.0f - driver.ideal(0, i);
+    sum += err * err;
+    n++;
+  }
+  return sqrtf((float)(sum / n));
+}
+
+void test_noise_drops_with_decimation(void)
+{
+  float r4 = noiseRms(2), r16 = noiseRms(4), r256 = noiseRms(8);
+  TEST_ASSERT_TRUE(r16 < r4 * 0.7f);
+  TEST_ASSERT_TRUE(r256 < r16 * 0.5f);
+  TEST_ASSERT_TRUE(r256 < 2.0f); // noise ±40 LSB (~23 LSB rms) turun >10x
+}
+
+int main(int argc, char** argv)
+{
+  UNITY_BEGIN();
+  RUN_TEST(test_dc_gain_after_warmup);
+  RUN_TEST(test_step_response_bounded);
+  RUN_TEST(test_noise_drops_with_decimation);
+  return UNITY_END();
+}
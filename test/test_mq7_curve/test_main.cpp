@@ -0,0 +1,38 @@
+// === Uji kurva CO MQ-7 (MQ7Curve.h) di host ===
+// Kurva datasheet dalam log10: 100 ppm pada Rs/Ro = 1 dan slope -0.7,
+// jadi 400 ppm pada Rs/Ro = 4^-0.7 dan 50 ppm pada Rs/Ro = 2^0.7.
+// Jalankan: pio test -e native_test
+
+#include <unity.h>
+#include <math.h>
+#include "MQ7Curve.h"
+
+void setUp(void) {}
+void tearDown(void) {}
+
+void test_reference_point_is_100ppm(void)
+{
+  TEST_ASSERT_FLOAT_WITHIN(0.01f, 100.0f, mq7CoPpm(1.0f));
+}
+
+void test_datasheet_points(void)
+{
+  TEST_ASSERT_FLOAT_WITHIN(1.0f, 400.0f, mq7CoPpm(powf(4.0f, -0.70f))); // Rs/Ro ~0.379
+  TEST_ASSERT_FLOAT_WITHIN(0.5f, 50.0f, mq7CoPpm(powf(2.0f, 0.70f)));   // Rs/Ro ~1.625
+}
+
+// Kurva log10 yang dihitung dengan log natural salah ~2.3x dalam dekade
+void test_natural_log_misreads_curve(void)
+{
+  float ratio = powf(4.0f, -0.70f);
+  TEST_ASSERT_TRUE(mqPercentage(ratio, MQ7_CO_CURVE) > 1000.0f);
+}
+
+int main(int argc, char** argv)
+{
+  UNITY_BEGIN();
+  RUN_TEST(test_reference_point_is_100ppm);
+  RUN_TEST(test_datasheet_points);
+  RUN_TEST(test_natural_log_misreads_curve);
+  return UNITY_END();
+}
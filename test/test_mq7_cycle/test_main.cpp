@@ -0,0 +1,164 @@
+// === Uji state machine siklus heater MQ-7 (mq7HeaterCycle) di host ===
+// Jam disimulasikan: now (ms) dimajukan manual, jadi 60 s / 90 s dan jendela
+// sampling diuji tanpa menunggu. Jalankan: pio test -e native_test
+
+#include <unity.h>
+#include <MQ7Cycle.h>
+
+// Akhir siklus pertama & titik latch relatif terhadap begin()
+#define CYCLE_MS ((uint32_t)(MQ7_HIGH_MS + MQ7_LOW_MS))
+#define LATCH_MS ((uint32_t)(MQ7_HIGH_MS + MQ7_LOW_MS - MQ7_SAMPLE_LEAD_MS))
+
+static mq7HeaterCycle cycle;
+
+void setUp(void) { cycle = mq7HeaterCycle(); }
+void tearDown(void) {}
+
+// Jalankan update() tiap tickMs dari..sampai (inklusif), kumpulkan event
+struct Sweep {
+  uint32_t samples;
+  uint32_t phases;
+  uint32_t missed;
+  uint32_t lastSampleAt;
+};
+
+static Sweep sweep(uint32_t from, uint32_t to, uint32_t tickMs)
+{
+  Sweep s = { 0, 0, 0, 0 };
+  for (uint32_t t = from; (int32_t)(to - t) >= 0; t += tickMs) {
+    uint8_t ev = cycle.update(t);
+    if (ev & MQ7_EVENT_SAMPLE) { s.samples++; s.lastSampleAt = t; }
+    if (ev & MQ7_EVENT_PHASE) s.phases++;
+    if (ev & MQ7_EVENT_MISSED) s.missed++;
+  }
+  return s;
+}
+
+void test_phase_high_60s_then_low_90s(void)
+{
+  cycle.begin(0);
+  TEST_ASSERT_EQUAL(MQ7_PHASE_HIGH, cycle.getPhase());
+  TEST_ASSERT_EQUAL_UINT32(MQ7_HIGH_MS, cycle.remaining(0));
+
+  TEST_ASSERT_EQUAL_HEX8(MQ7_EVENT_NONE, cycle.update(MQ7_HIGH_MS - 1));
+  TEST_ASSERT_EQUAL(MQ7_PHASE_HIGH, cycle.getPhase());
+
+  TEST_ASSERT_EQUAL_HEX8(MQ7_EVENT_PHASE, cycle.update(MQ7_HIGH_MS));
+  TEST_ASSERT_EQUAL(MQ7_PHASE_LOW, cycle.getPhase());
+  TEST_ASSERT_EQUAL_UINT32(MQ7_LOW_MS, cycle.remaining(MQ7_HIGH_MS));
+
+  cycle.update(CYCLE_MS - 1);
+  TEST_ASSERT_EQUAL(MQ7_PHASE_LOW, cycle.getPhase());
+  TEST_ASSERT_EQUAL_HEX8(MQ7_EVENT_PHASE, cycle.update(CYCLE_MS));
+  TEST_ASSERT_EQUAL(MQ7_PHASE_HIGH, cycle.getPhase());
+  TEST_ASSERT_EQUAL_UINT32(1, cycle.getCycles());
+  TEST_ASSERT_EQUAL_UINT32(0, cycle.getMissed());
+}
+
+void test_latch_once_at_end_of_low_phase(void)
+{
+  cycle.begin(0);
+  Sweep before = sweep(0, LATCH_MS - 1, 100);
+  TEST_ASSERT_EQUAL_UINT32(0, before.samples);
+
+  TEST_ASSERT_EQUAL_HEX8(MQ7_EVENT_SAMPLE, cycle.update(LATCH_MS));
+  TEST_ASSERT_EQUAL(MQ7_PHASE_LOW, cycle.getPhase());
+
+  // Sisa jendela sampai akhir fase low: tidak ada latch kedua
+  Sweep rest = sweep(LATCH_MS + 100, CYCLE_MS - 1, 100);
+  TEST_ASSERT_EQUAL_UINT32(0, rest.samples);
+}
+
+void test_ten_cycles_latch_every_150s(void)
+{
+  cycle.begin(0);
+  uint32_t samples = 0;
+  for (uint32_t t = 0; t < 10 * CYCLE_MS; t += 100) {
+    if (cycle.update(t) & MQ7_EVENT_SAMPLE) {
+      TEST_ASSERT_EQUAL_UINT32(LATCH_MS, t % CYCLE_MS);
+      samples++;
+    }
+  }
+  TEST_ASSERT_EQUAL_UINT32(10, samples);
+  TEST_ASSERT_EQUAL_UINT32(9, cycle.getCycles()); // siklus ke-10 berakhir tepat di 10 * CYCLE_MS
+  TEST_ASSERT_EQUAL_UINT32(0, cycle.getMissed());
+}
+
+void test_late_update_inside_window_still_latches(void)
+{
+  cycle.begin(0);
+  cycle.update(MQ7_HIGH_MS);
+  // Loop sempat tersendat, panggilan berikutnya 1 s sebelum fase low berakhir
+  TEST_ASSERT_EQUAL_HEX8(MQ7_EVENT_SAMPLE, cycle.update(CYCLE_MS - 1000));
+}
+
+void test_missed_window_records_missed_not_stale_sample(void)
+{
+  cycle.begin(0);
+  cycle.update(LATCH_MS - 1000);
+  // Lompat melewati jendela sampling dan akhir fase low
+  uint8_t ev = cycle.update(CYCLE_MS + 1000);
+  TEST_ASSERT_EQUAL_HEX8(MQ7_EVENT_PHASE | MQ7_EVENT_MISSED, ev);
+  TEST_ASSERT_EQUAL(MQ7_PHASE_HIGH, cycle.getPhase());
+  TEST_ASSERT_EQUAL_UINT32(1, cycle.getMissed());
+
+  // Siklus berikutnya normal lagi, tetap sejajar dengan begin()
+  Sweep next = sweep(CYCLE_MS + 1100, 2 * CYCLE_MS, 100);
+  TEST_ASSERT_EQUAL_UINT32(1, next.samples);
+  TEST_ASSERT_EQUAL_UINT32(CYCLE_MS + LATCH_MS, next.lastSampleAt);
+}
+
+void test_very_late_update_advances_phase_by_phase(void)
+{
+  cycle.begin(0);
+  uint8_t ev = cycle.update(3 * CYCLE_MS + 10);
+  TEST_ASSERT_EQUAL_HEX8(MQ7_EVENT_PHASE | MQ7_EVENT_MISSED, ev);
+  TEST_ASSERT_EQUAL_UINT32(3, cycle.getCycles());
+  TEST_ASSERT_EQUAL_UINT32(3, cycle.getMissed());
+  TEST_ASSERT_EQUAL(MQ7_PHASE_HIGH, cycle.getPhase());
+  TEST_ASSERT_EQUAL_UINT32(MQ7_HIGH_MS - 10, cycle.remaining(3 * CYCLE_MS + 10));
+}
+
+void test_restart_mid_cycle_starts_fresh_high_phase(void)
+{
+  cycle.begin(0);
+  sweep(0, MQ7_HIGH_MS + 40000, 100); // di tengah fase low
+  TEST_ASSERT_EQUAL(MQ7_PHASE_LOW, cycle.getPhase());
+
+  const uint32_t restart = MQ7_HIGH_MS + 40000;
+  cycle.begin(restart);
+  TEST_ASSERT_EQUAL(MQ7_PHASE_HIGH, cycle.getPhase());
+  TEST_ASSERT_EQUAL_UINT32(0, cycle.getCycles());
+  TEST_ASSERT_EQUAL_UINT32(MQ7_HIGH_MS, cycle.remaining(restart));
+
+  // Jendela lama (LATCH_MS) tidak boleh memicu latch, fase low sisa tidak dipakai
+  Sweep s = sweep(restart, restart + CYCLE_MS, 100);
+  TEST_ASSERT_EQUAL_UINT32(1, s.samples);
+  TEST_ASSERT_EQUAL_UINT32(restart + LATCH_MS, s.lastSampleAt);
+  TEST_ASSERT_EQUAL_UINT32(0, cycle.getMissed());
+}
+
+void test_millis_wraparound(void)
+{
+  const uint32_t start = UINT32_MAX - 30000; // wrap di tengah fase high
+  cycle.begin(start);
+  Sweep s = sweep(start, start + CYCLE_MS, 100);
+  TEST_ASSERT_EQUAL_UINT32(2, s.phases);
+  TEST_ASSERT_EQUAL_UINT32(1, s.samples);
+  TEST_ASSERT_EQUAL_UINT32((uint32_t)(start + LATCH_MS), s.lastSampleAt);
+  TEST_ASSERT_EQUAL_UINT32(0, s.missed);
+}
+
+int main(int argc, char** argv)
+{
+  UNITY_BEGIN();
+  RUN_TEST(test_phase_high_60s_then_low_90s);
+  RUN_TEST(test_latch_once_at_end_of_low_phase);
+  RUN_TEST(test_ten_cycles_latch_every_150s);
+  RUN_TEST(test_late_update_inside_window_still_latches);
+  RUN_TEST(test_missed_window_records_missed_not_stale_sample);
+  RUN_TEST(test_very_late_update_advances_phase_by_phase);
+  RUN_TEST(test_restart_mid_cycle_starts_fresh_high_phase);
+  RUN_TEST(test_millis_wraparound);
+  return UNITY_END();
+}
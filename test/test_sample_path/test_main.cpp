@@ -0,0 +1,293 @@
+// === Uji bit-exact jalur sampel float vs Q16.16 di host ===
+// basicMovingAverage, roundToNearest005 dan classifyReading dijalankan untuk
+// float dan q16_16 dengan input yang sama, lalu dicocokkan sampel per sampel
+// dengan keluaran acuan yang disimpan di sini (bit float dan raw Q16.16),
+// termasuk jalur tidak valid (NAN / invalid) dan saturasi.
+// Jalankan: pio test -e native_test
+//
+// Acuan berubah hanya jika perilaku filter/klasifikasi memang diubah; dalam
+// hal itu perbarui tabel dan catat alasannya di commit.
+
+#include <unity.h>
+#include <stdio.h>
+#include <string.h>
+#include <SignalProcessing.h>
+#include "condition.h"
+
+void setUp(void) {}
+void tearDown(void) {}
+
+static uint32_t floatBits(float v)
+{
+  uint32_t bits;
+  memcpy(&bits, &v, sizeof(bits));
+  return bits;
+}
+
+// Satu LSB Q16.16; float dan Q16.16 boleh berbeda paling banyak 2 LSB
+// karena kuantisasi input, bukan karena aritmetika.
+#define Q16_LSB (1.0f / 65536.0f)
+
+// === Moving average (window 5) ===
+// Suhu dengan pecahan yang tidak representatif di Q16.16, dua NAN beruntun
+// (dilewati, nilai terakhir dipertahankan), lalu turun ke negatif.
+static const float MA_INPUT[] = {
+  25.0f, 25.0625f, 25.1f, 24.97f, NAN, 25.33f, 26.01f, 31.7f, 48.25f, NAN,
+  NAN, 52.125f, 60.3f, 59.99f, 58.0f, 57.45f, -3.2f, -10.05f, 0.0f, 12.345f
+};
+
+struct MaExpected {
+  uint32_t floatBits;
+  int32_t q16Raw;
+};
+
+static const MaExpected MA_EXPECTED[] = {
+  { 0x41C80000u, 1638400 }, // 25.000000
+  { 0x41C84000u, 1640448 }, // 25.031250
+  { 0x41C86EEFu, 1641950 }, // 25.054167
+  { 0x41C843D7u, 1640571 }, // 25.033125
+  { 0x41C843D7u, 1640571 }, // NAN dilewati
+  { 0x41C8BD71u, 1644462 }, // 25.092501
+  { 0x41CA5B23u, 1657700 }, // 25.294500
+  { 0x41D4F9DBu, 1744699 }, // 26.622000
+  { 0x41FA041Au, 2048131 }, // 31.252003
+  { 0x41FA041Au, 2048131 }, // NAN dilewati
+  { 0x41FA041Au, 2048131 }, // NAN dilewati
+  { 0x4212BB65u, 2404057 }, // 36.683002
+  { 0x422EB540u, 2862416 }, // 43.677002
+  { 0x4249E45Bu, 3307799 }, // 50.473003
+  { 0x425EEE9Au, 3652518 }, // 55.733009
+  { 0x42664AC3u, 3773104 }, // 57.573009
+  { 0x423A0834u, 3047948 }, // 46.508011
+  { 0x4201C086u, 2125857 }, // 32.438011
+  { 0x41A38523u, 1339556 }, // 20.440008
+  { 0x4134F1B3u, 741147 },  // 11.309009
+};
+
+#define MA_COUNT (sizeof(MA_INPUT) / sizeof(MA_INPUT[0]))
+
+void test_moving_average_matches_reference(void)
+{
+  TEST_ASSERT_EQUAL(MA_COUNT, sizeof(MA_EXPECTED) / sizeof(MA_EXPECTED[0]));
+  basicMovingAverage<float> f(5);
+  basicMovingAverage<q16_16> q(5);
+  TEST_ASSERT_TRUE(f.init());
+  TEST_ASSERT_TRUE(q.init());
+
+  char msg[32];
+  for (size_t i = 0; i < MA_COUNT; i++) {
+    snprintf(msg, sizeof(msg), "sampel %u", (unsigned)i);
+    float fv = f.update(MA_INPUT[i]);
+    q16_16 qv = q.update(q16_16(MA_INPUT[i]));
+    TEST_ASSERT_EQUAL_HEX32_MESSAGE(MA_EXPECTED[i].floatBits, floatBits(fv), msg);
+    TEST_ASSERT_EQUAL_INT32_MESSAGE(MA_EXPECTED[i].q16Raw, qv.raw, msg);
+    TEST_ASSERT_FLOAT_WITHIN_MESSAGE(2 * Q16_LSB, fv, qv.toFloat(), msg);
+    TEST_ASSERT_EQUAL_HEX32_MESSAGE(floatBits(fv), floatBits(f.getValue()), msg);
+    TEST_ASSERT_EQUAL_INT32_MESSAGE(qv.raw, q.getValue().raw, msg);
+  }
+}
+
+void test_moving_average_all_invalid_stays_zero(void)
+{
+  basicMovingAverage<float> f(5);
+  basicMovingAverage<q16_16> q(5);
+  f.init();
+  q.init();
+  for (int i = 0; i < 10; i++) {
+    TEST_ASSERT_EQUAL_HEX32(0, floatBits(f.update(NAN)));
+    TEST_ASSERT_EQUAL_INT32(0, q.update(q16_16::invalid()).raw);
+  }
+  TEST_ASSERT_EQUAL_INT32(0, q.getCount());
+  TEST_ASSERT_EQUAL_INT32(0, f.getCount());
+}
+
+// Jumlah 25 sampel 2000.5 (50012.5) melewati rentang Q16.16 (±32768).
+// Jumlah 64-bit membuat rata-rata tetap eksak dan pulih penuh setelah turun.
+void test_moving_average_sum_beyond_q16_range(void)
+{
+  basicMovingAverage<float> f(25);
+  basicMovingAverage<q16_16> q(25);
+  f.init();
+  q.init();
+
+  for (int i = 0; i < 30; i++) {
+    f.update(2000.5f);
+    q.update(q16_16(2000.5f));
+  }
+  TEST_ASSERT_EQUAL_HEX32(floatBits(2000.5f), floatBits(f.getValue()));
+  TEST_ASSERT_EQUAL_INT32(q16_16(2000.5f).raw, q.getValue().raw);
+
+  for (int i = 0; i < 24; i++) q.update(q16_16(20.25f));
+  // 1 x 2000.5 + 24 x 20.25 = 2486.5 / 25 = 99.46
+  TEST_ASSERT_EQUAL_INT32(q16_16(99.46f).raw, q.getValue().raw);
+  q.update(q16_16(20.25f));
+  TEST_ASSERT_EQUAL_INT32(q16_16(20.25f).raw, q.getValue().raw);
+}
+
+// Input di luar rentang dijepit saat konversi; rata-rata tidak wrap dan tidak
+// pernah menghasilkan penanda invalid.
+void test_moving_average_saturated_input(void)
+{
+  basicMovingAverage<q16_16> q(5);
+  q.init();
+  for (int i = 0; i < 5; i++) q.update(q16_16(1.0e6f));
+  TEST_ASSERT_EQUAL_INT32(q16_16::RAW_MAX, q.getValue().raw);
+  for (int i = 0; i < 5; i++) q.update(q16_16(-1.0e6f));
+  TEST_ASSERT_EQUAL_INT32(q16_16::RAW_MIN, q.getValue().raw);
+  TEST_ASSERT_TRUE(q.getValue().isValid());
+  q.update(q16_16(0));
+  // (4 x RAW_MIN + 0) / 5, dibulatkan half away from zero
+  TEST_ASSERT_EQUAL_INT32(-1717986918, q.getValue().raw);
+}
+
+// === Operasi FixedPoint di tepi rentang ===
+void test_fixed_point_saturation(void)
+{
+  const q16_16 big = q16_16::fromRaw(q16_16::RAW_MAX);
+  const q16_16 small = q16_16::fromRaw(q16_16::RAW_MIN);
+  TEST_ASSERT_EQUAL_INT32(q16_16::RAW_MAX, (big + q16_16(1)).raw);
+  TEST_ASSERT_EQUAL_INT32(q16_16::RAW_MIN, (small - q16_16(1)).raw);
+  TEST_ASSERT_EQUAL_INT32(q16_16::RAW_MAX, (-small).raw);
+  TEST_ASSERT_EQUAL_INT32(q16_16::RAW_MAX, (q16_16(300) * q16_16(300)).raw);
+  TEST_ASSERT_EQUAL_INT32(q16_16::RAW_MIN, (q16_16(-300) * q16_16(300)).raw);
+  TEST_ASSERT_EQUAL_INT32(q16_16::RAW_MAX, (q16_16(20000) * 2).raw);
+  TEST_ASSERT_EQUAL_INT32(q16_16::RAW_MAX, (q16_16(1) / q16_16(0)).raw);
+  TEST_ASSERT_EQUAL_INT32(q16_16::RAW_MIN, (q16_16(-1) / 0).raw);
+  TEST_ASSERT_EQUAL_INT32(q16_16::RAW_MAX, q16_16(40000).raw);
+  TEST_ASSERT_EQUAL_INT32(q16_16::RAW_MAX, q16_16(INFINITY).raw);
+  TEST_ASSERT_EQUAL_INT32(q16_16::RAW_MIN, q16_16(-INFINITY).raw);
+  TEST_ASSERT_FALSE(q16_16(NAN).isValid());
+  TEST_ASSERT_FLOAT_IS_NAN(q16_16::invalid().toFloat());
+  // Pembulatan half away from zero, simetris
+  TEST_ASSERT_EQUAL_INT32(1, (q16_16::fromRaw(3) / 4).raw);
+  TEST_ASSERT_EQUAL_INT32(-1, (q16_16::fromRaw(-3) / 4).raw);
+  TEST_ASSERT_EQUAL_INT32(1, (q16_16::fromRaw(2) / 4).raw);
+  TEST_ASSERT_EQUAL_INT32(-1, (q16_16::fromRaw(-2) / 4).raw);
+  TEST_ASSERT_EQUAL_INT(0, sampleToInt(q16_16::invalid()));
+  TEST_ASSERT_EQUAL_INT(0, sampleToInt(NAN));
+  TEST_ASSERT_EQUAL_INT(-3, sampleToInt(q16_16(-2.5f)));
+  TEST_ASSERT_EQUAL_INT(-3, sampleToInt(-2.5f));
+}
+
+// === roundToNearest005 ===
+struct RoundCase {
+  float input;
+  uint32_t floatBits;
+  int32_t q16Raw;
+};
+
+static const RoundCase ROUND_CASES[] = {
+  { 0.0f, 0x00000000u, 0 },
+  { 0.024f, 0x00000000u, 0 },
+  { 0.026f, 0x3D4CCCCDu, 3277 },         // 0.05
+  { 1.074f, 0x3F866666u, 68813 },        // 1.05
+  { -1.074f, 0xBF866666u, -68813 },      // -1.05
+  { 25.3349f, 0x41CACCCDu, 1661338 },    // 25.35
+  { 1013.27f, 0x447D5000u, 66404352 },   // 1013.25
+  { 32767.9f, 0x46FFFFCDu, 2147477094 }, // tepi atas Q16.16
+  { -32767.9f, 0xC6FFFFCDu, -2147477094 },
+};
+
+void test_round_to_nearest_005_matches_reference(void)
+{
+  char msg[32];
+  for (size_t i = 0; i < sizeof(ROUND_CASES) / sizeof(ROUND_CASES[0]); i++) {
+    const RoundCase& c = ROUND_CASES[i];
+    snprintf(msg, sizeof(msg), "input %.4f", c.input);
+    float fv = roundToNearest005(c.input);
+    q16_16 qv = roundToNearest005(q16_16(c.input));
+    TEST_ASSERT_EQUAL_HEX32_MESSAGE(c.floatBits, floatBits(fv), msg);
+    TEST_ASSERT_EQUAL_INT32_MESSAGE(c.q16Raw, qv.raw, msg);
+    TEST_ASSERT_FLOAT_WITHIN_MESSAGE(2 * Q16_LSB, fv, qv.toFloat(), msg);
+  }
+  TEST_ASSERT_FALSE(roundToNearest005(q16_16::invalid()).isValid());
+  TEST_ASSERT_FLOAT_IS_NAN(roundToNearest005(NAN));
+}
+
+// Titik tengah persis (0.025, 1.075) tidak representatif di Q16.16: raw-nya
+// sedikit di bawah titik tengah sehingga dibulatkan ke bawah, float ke atas.
+// Selisih satu langkah 0.05 ini disengaja dan dikunci di sini.
+void test_round_to_nearest_005_midpoint(void)
+{
+  TEST_ASSERT_EQUAL_HEX32(0x3D4CCCCDu, floatBits(roundToNearest005(0.025f)));
+  TEST_ASSERT_EQUAL_INT32(0, roundToNearest005(q16_16(0.025f)).raw);
+  TEST_ASSERT_EQUAL_HEX32(0x3F8CCCCDu, floatBits(roundToNearest005(1.075f)));
+  TEST_ASSERT_EQUAL_INT32(68813, roundToNearest005(q16_16(1.075f)).raw);
+  TEST_ASSERT_EQUAL_HEX32(0xBD4CCCCDu, floatBits(roundToNearest005(-0.025f)));
+  TEST_ASSERT_EQUAL_INT32(0, roundToNearest005(q16_16(-0.025f)).raw);
+}
+
+// === classifyReading ===
+struct ClassifyCase {
+  const char* name;
+  float temps[4];
+  float ambient;
+  float humidity;
+  int mq2;
+  int mq7;
+  int expected;
+};
+
+static const ClassifyCase CLASSIFY_CASES[] = {
+  { "normal", { 25.0f, 25.1f, 24.9f, 25.2f }, 25.0f, 55.0f, 300, 5, CONDITION_NORMAL },
+  { "panas + kering", { 55.0f, 56.0f, 54.0f, 55.0f }, NAN, 25.0f, 300, 5, CONDITION_WASPADA },
+  { "deviasi + asap", { 25.0f, 25.0f, 25.0f, 40.0f }, 25.0f, 55.0f, 450, 5, CONDITION_WASPADA },
+  { "rata-rata tepat 50", { 50.0f, 50.0f, 50.0f, 50.0f }, NAN, 30.0f, 400, 20, CONDITION_NORMAL },
+  { "rata-rata 50.01", { 50.01f, 50.01f, 50.01f, 50.01f }, NAN, 29.99f, 401, 0, CONDITION_BAHAYA },
+  { "deviasi tepat 5", { 20.0f, 30.0f, NAN, NAN }, NAN, 50.0f, 0, 40, CONDITION_WASPADA },
+  { "deviasi 5.01", { 19.99f, 30.01f, NAN, NAN }, NAN, 50.0f, 0, 40, CONDITION_BAHAYA },
+  { "CO tinggi", { 25.0f, 25.0f, 25.0f, 25.0f }, 25.0f, 55.0f, 300, 60, CONDITION_BAHAYA },
+  { "kebakaran", { 80.0f, 85.0f, 60.0f, 90.0f }, 70.0f, 15.0f, 900, 80, CONDITION_FIRE },
+  { "DS18B20 kosong", { NAN, NAN, NAN, NAN }, NAN, 40.0f, 0, 0, CONDITION_NORMAL },
+  { "hanya ambient", { NAN, NAN, NAN, NAN }, 70.0f, 40.0f, 500, 0, CONDITION_WASPADA },
+  { "ambient tidak valid", { 52.0f, 24.0f, NAN, 51.0f }, NAN, 45.0f, 0, 0, CONDITION_NORMAL },
+  { "saturasi atas", { 1.0e6f, NAN, NAN, NAN }, NAN, 50.0f, 999, 0, CONDITION_WASPADA },
+  { "saturasi bawah", { -1.0e6f, 25.0f, 25.0f, 25.0f }, NAN, 20.0f, 0, 0, CONDITION_WASPADA },
+  // Tanpa BME280: kelembapan tidak valid tidak dihitung kering di kedua build
+  { "tanpa BME280", { 25.0f, 25.0f, 25.0f, 25.0f }, NAN, NAN, 300, 5, CONDITION_NORMAL },
+  { "tanpa BME280, panas", { 55.0f, 55.0f, 55.0f, 55.0f }, NAN, NAN, 300, 0, CONDITION_NORMAL },
+  { "tanpa BME280, panas + asap", { 55.0f, 55.0f, 55.0f, 55.0f }, NAN, NAN, 450, 0, CONDITION_WASPADA },
+};
+
+void test_classify_float_and_q16_match_reference(void)
+{
+  for (size_t i = 0; i < sizeof(CLASSIFY_CASES) / sizeof(CLASSIFY_CASES[0]); i++) {
+    const ClassifyCase& c = CLASSIFY_CASES[i];
+    q16_16 qTemps[4];
+    for (int t = 0; t < 4; t++) qTemps[t] = q16_16(c.temps[t]);
+    int fc = classifyReading(c.temps, 4, c.ambient, c.humidity, c.mq2, c.mq7);
+    int qc = classifyReading(qTemps, 4, q16_16(c.ambient), q16_16(c.humidity), c.mq2, c.mq7);
+    TEST_ASSERT_EQUAL_INT_MESSAGE(c.expected, fc, c.name);
+    TEST_ASSERT_EQUAL_INT_MESSAGE(c.expected, qc, c.name);
+  }
+}
+
+void test_average_temperature_skips_invalid(void)
+{
+  const float f[] = { 24.0f, NAN, 26.5f, NAN };
+  const q16_16 q[] = { q16_16(24.0f), q16_16::invalid(), q16_16(26.5f), q16_16::invalid() };
+  int fValid = -1, qValid = -1;
+  TEST_ASSERT_EQUAL_HEX32(floatBits(25.25f), floatBits(averageTemperature(f, 4, &fValid)));
+  TEST_ASSERT_EQUAL_INT32(q16_16(25.25f).raw, averageTemperature(q, 4, &qValid).raw);
+  TEST_ASSERT_EQUAL_INT(2, fValid);
+  TEST_ASSERT_EQUAL_INT(2, qValid);
+
+  // Jumlah melewati rentang Q16.16 tetap eksak
+  const q16_16 hot[] = { q16_16(30000), q16_16(30000), q16_16(30000), q16_16(30000) };
+  TEST_ASSERT_EQUAL_INT32(q16_16(30000).raw, averageTemperature(hot, 4).raw);
+}
+
+int main(int argc, char** argv)
+{
+  UNITY_BEGIN();
+  RUN_TEST(test_moving_average_matches_reference);
+  RUN_TEST(test_moving_average_all_invalid_stays_zero);
+  RUN_TEST(test_moving_average_sum_beyond_q16_range);
+  RUN_TEST(test_moving_average_saturated_input);
+  RUN_TEST(test_fixed_point_saturation);
+  RUN_TEST(test_round_to_nearest_005_matches_reference);
+  RUN_TEST(test_round_to_nearest_005_midpoint);
+  RUN_TEST(test_classify_float_and_q16_match_reference);
+  RUN_TEST(test_average_temperature_skips_invalid);
+  return UNITY_END();
+}
@@ -0,0 +1,92 @@
+// === Uji round trip record trace (trace_format.h) di host ===
+// Nilai yang tidak ada (DS18B20 kosong, BME280 tidak terpasang/belum terbaca)
+// harus kembali sebagai NAN, bukan 0 % / 0 hPa / -327.68 °C.
+// Jalankan: pio test -e native_test
+
+#include <unity.h>
+#include <math.h>
+#include "trace_format.h"
+
+void setUp(void) {}
+void tearDown(void) {}
+
+static TraceSample roundTrip(const TraceSample& in, size_t* used = 0)
+{
+  uint8_t buf[TRACE_RECORD_MAX_SIZE];
+  size_t len = encodeTraceSample(in, buf);
+  TraceSample out;
+  size_t n = decodeTraceSample(buf, len, out);
+  TEST_ASSERT_EQUAL_UINT32(len, n);
+  if (used) *used = n;
+  return out;
+}
+
+void test_values_round_trip(void)
+{
+  TraceSample s = { 123456, 412, 35, 2, { 24.51f, -10.25f }, 55.2f, 1013.25f, 26.75f };
+  TraceSample r = roundTrip(s);
+  TEST_ASSERT_EQUAL_UINT32(123456, r.timeMs);
+  TEST_ASSERT_EQUAL_INT(412, r.mq2);
+  TEST_ASSERT_EQUAL_INT(35, r.mq7);
+  TEST_ASSERT_EQUAL_INT(2, r.tempCount);
+  TEST_ASSERT_FLOAT_WITHIN(0.005f, 24.51f, r.temps[0]);
+  TEST_ASSERT_FLOAT_WITHIN(0.005f, -10.25f, r.temps[1]);
+  TEST_ASSERT_FLOAT_WITHIN(0.005f, 55.2f, r.humidity);
+  TEST_ASSERT_FLOAT_WITHIN(0.005f, 1013.25f, r.pressure);
+  TEST_ASSERT_FLOAT_WITHIN(0.005f, 26.75f, r.ambient);
+}
+
+void test_missing_readings_round_trip_as_nan(void)
+{
+  TraceSample s = { 1000, 300, 0, 2, { NAN, 25.0f }, NAN, NAN, NAN };
+  TraceSample r = roundTrip(s);
+  TEST_ASSERT_FLOAT_IS_NAN(r.temps[0]);
+  TEST_ASSERT_FLOAT_WITHIN(0.005f, 25.0f, r.temps[1]);
+  TEST_ASSERT_FLOAT_IS_NAN(r.humidity);
+  TEST_ASSERT_FLOAT_IS_NAN(r.pressure);
+  TEST_ASSERT_FLOAT_IS_NAN(r.ambient);
+}
+
+// Nilai valid di tepi rentang tidak boleh jatuh ke sentinel
+void test_extremes_stay_valid(void)
+{
+  TraceSample s = { 0, 0, 0, 1, { -400.0f }, 0.0f, 0.0f, -400.0f };
+  TraceSample r = roundTrip(s);
+  TEST_ASSERT_FLOAT_WITHIN(0.005f, -327.67f, r.temps[0]);
+  TEST_ASSERT_FLOAT_WITHIN(0.005f, 0.0f, r.humidity);
+  TEST_ASSERT_FLOAT_WITHIN(0.005f, 0.0f, r.pressure);
+  TEST_ASSERT_FLOAT_WITHIN(0.005f, -327.67f, r.ambient);
+
+  s.humidity = 1000.0f; // di atas 655.34 %, dijepit di bawah sentinel
+  r = roundTrip(s);
+  TEST_ASSERT_FLOAT_WITHIN(0.005f, 655.34f, r.humidity);
+}
+
+// Trace v2 menulis NAN kelembapan/tekanan sebagai 0 dan ambient -32768
+void test_version2_zero_reads_as_missing(void)
+{
+  const uint8_t rec[] = {
+    0xE8, 0x03, 0x00, 0x00, // timeMs 1000
+    0x2C, 0x01,             // mq2 300
+    0x00, 0x00,             // mq7 0
+    0x00,                   // tanpa DS18B20
+    0x00, 0x00,             // humidity 0
+    0x00, 0x00, 0x00, 0x00, // pressure 0
+    0x00, 0x80,             // ambient -32768
+  };
+  TraceSample r;
+  TEST_ASSERT_EQUAL_UINT32(sizeof(rec), decodeTraceSample(rec, sizeof(rec), r, 2));
+  TEST_ASSERT_FLOAT_IS_NAN(r.humidity);
+  TEST_ASSERT_FLOAT_IS_NAN(r.pressure);
+  TEST_ASSERT_FLOAT_IS_NAN(r.ambient);
+}
+
+int main(int argc, char** argv)
+{
+  UNITY_BEGIN();
+  RUN_TEST(test_values_round_trip);
+  RUN_TEST(test_missing_readings_round_trip_as_nan);
+  RUN_TEST(test_extremes_stay_valid);
+  RUN_TEST(test_version2_zero_reads_as_missing);
+  return UNITY_END();
+}
@@ -0,0 +1,147 @@
+#!/usr/bin/env python3
+"""Decode log biner firmware (build flag -D LOG_BINARY).
+
+Format string tidak dikirim oleh firmware; id 16-bit tiap record dicocokkan
+dengan hash semua pemanggilan LOG_E/W/I/D di source (sama dengan logId() di
+include/log.h).
+
+    python tools/logdecode.py capture.bin
+    python tools/logdecode.py /dev/ttyUSB0 --baud 115200   (butuh pyserial)
+"""
+
+import argparse
+import os
+import re
+import struct
+import sys
+
+SYNC = 0xA5
+ID_DROPPED = 0x0000
+LEVELS = "-EWID"
+SOURCE_DIRS = ("src", "include", "lib")
+LOG_CALL = re.compile(r'LOG_[EWID]\s*\(\s*"((?:[^"\\]|\\.)*)"')
+SPEC = re.compile(r"%([-+ #0]*(?:\d+|\*)?(?:\.(?:\d+|\*))?)(hh|h|ll|l|z)?([diuxXcfeEgGsp%])")
+ESCAPES = {"n": "\n", "t": "\t", "r": "\r", '"': '"', "\\": "\\", "'": "'", "0": "\0"}
+
+
+def unescape(literal):
+    out, i = [], 0
+    while i < len(literal):
+        c = literal[i]
+        if c == "\\" and i + 1 < len(literal):
+            out.append(ESCAPES.get(literal[i + 1], literal[i + 1]))
+            i += 2
+        else:
+            out.append(c)
+            i += 1
+    return "".join(out)
+
+
+def log_id(fmt):
+    h = 2166136261
+    for b in fmt.encode("utf-8"):
+        h = ((h ^ b) * 16777619) & 0xFFFFFFFF
+    return ((h >> 16) ^ (h & 0xFFFF)) & 0xFFFF
+
+
+def load_formats(root):
+    formats = {}
+    for d in SOURCE_DIRS:
+        for dirpath, _, files in os.walk(os.path.join(root, d)):
+            for name in files:
+                if not name.endswith((".cpp", ".h", ".c", ".ino")):
+                    continue
+                with open(os.path.join(dirpath, name), encoding="utf-8", errors="replace") as f:
+                    for literal in LOG_CALL.findall(f.read()):
+                        fmt = unescape(literal)
+                        i = log_id(fmt)
+                        if i in formats and formats[i] != fmt:
+                            print("warning: hash collision 0x%04x: %r / %r" % (i, formats[i], fmt), file=sys.stderr)
+                        formats[i] = fmt
+    return formats
+
+
+def render(fmt, payload):
+    out, pos, last = [], 0, 0
+    for m in SPEC.finditer(fmt):
+        out.append(fmt[last:m.start()])
+        last = m.end()
+        flags, length, conv = m.groups()
+        if conv == "%":
+            out.append("%")
+            continue
+        # Lebar/presisi '*' dikirim sebagai argumen int tersendiri sebelum nilainya
+        while "*" in flags:
+            (n,) = struct.unpack_from("<i", payload, pos)
+            flags = flags.replace("*", str(n), 1)
+            pos += 4
+        if conv == "s":
+            n = payload[pos]
+            out.append(("%" + flags + "s") % payload[pos + 1:pos + 1 + n].decode("utf-8", "replace"))
+            pos += 1 + n
+        elif conv in "feEgG":
+            (v,) = struct.unpack_from("<f", payload, pos)
+            out.append(("%" + flags + conv) % v)
+            pos += 4
+        else:
+            size = 8 if length == "ll" else 4
+            signed = conv in "di"
+            v = int.from_bytes(payload[pos:pos + size], "little", signed=signed)
+            out.append(("%" + flags + {"i": "d", "u": "d", "p": "x"}.get(conv, conv)) % v)
+            pos += size
+    out.append(fmt[last:])
+    return "".join(out)
+
+
+def decode(stream, formats, out):
+    buf = b""
+    while True:
+        chunk = stream.read(256)
+        if not chunk:
+            break
+        buf += chunk
+        while True:
+            start = buf.find(bytes([SYNC]))
+            if start < 0:
+                buf = b""
+                break
+            buf = buf[start:]
+            if len(buf) < 9 or len(buf) < 9 + buf[8]:
+                break
+            level = buf[1]
+            rec_id, ms, n = struct.unpack_from("<HIB", buf, 2)
+            payload = buf[9:9 + n]
+            buf = buf[9 + n:]
+            if rec_id == ID_DROPPED and level == 0:
+                text = "log: %u record dibuang" % struct.unpack_from("<I", payload)[0]
+                level = 2
+            elif rec_id in formats:
+                try:
+                    text = render(formats[rec_id], payload)
+                except (IndexError, struct.error, TypeError, ValueError):
+                    text = "<0x%04x: argumen rusak>" % rec_id
+            else:
+                text = "<0x%04x: format tidak dikenal> %s" % (rec_id, payload.hex())
+            lvl = LEVELS[level] if level < len(LEVELS) else "?"
+            out.write("%s %d | %s\n" % (lvl, ms, text.rstrip("\n")))
+            out.flush()
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    ap.add_argument("input", help="file capture atau port serial")
+    ap.add_argument("--baud", type=int, default=115200)
+    ap.add_argument("--root", default=os.path.join(os.path.dirname(os.path.abspath(__file__)), ".."))
+    args = ap.parse_args()
+
+    formats = load_formats(args.root)
+    if args.input.startswith(("/dev/", "COM")):
+        import serial
+        stream = serial.Serial(args.input, args.baud)
+    else:
+        stream = open(args.input, "rb")
+    decode(stream, formats, sys.stdout)
+
+
+if __name__ == "__main__":
+    main()
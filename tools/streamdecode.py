@@ -0,0 +1,119 @@
+#!/usr/bin/env python3
+"""Decode stream biner sampel mentah dari Bluetooth (build flag -D BT_STREAM).
+
+Format batch ada di include/stream_batch.h, record sampel sama dengan
+include/trace_format.h. Output CSV ke stdout; batch yang hilang (lompatan seq)
+dan batch rusak (CRC) dilaporkan ke stderr.
+
+    python tools/streamdecode.py capture.bin > samples.csv
+    python tools/streamdecode.py /dev/rfcomm0            (butuh pyserial)
+    python tools/streamdecode.py COM7 --baud 115200
+"""
+
+import argparse
+import struct
+import sys
+
+SYNC = b"\xa5\x5a"
+VERSION = 2  # record trace v3: sentinel NAN untuk BME280
+HEADER_SIZE = 8
+CRC_SIZE = 2
+NAN_TEMP = -32768
+NAN_HUMIDITY = 0xFFFF
+NAN_PRESSURE = 0xFFFFFFFF
+
+
+def crc16(data, crc=0xFFFF):
+    for b in data:
+        crc ^= b << 8
+        for _ in range(8):
+            crc = ((crc << 1) ^ 0x1021) if crc & 0x8000 else (crc << 1)
+            crc &= 0xFFFF
+    return crc
+
+
+def decode_record(payload, pos):
+    ms, mq2, mq7, n = struct.unpack_from("<IHhB", payload, pos)
+    pos += 9
+    temps = struct.unpack_from("<%dh" % n, payload, pos)
+    pos += 2 * n
+    hum, prs, amb = struct.unpack_from("<HIh", payload, pos)
+    pos += 8
+    temps = ["" if t == NAN_TEMP else "%.2f" % (t / 100.0) for t in temps]
+    bme = ["" if hum == NAN_HUMIDITY else "%.2f" % (hum / 100.0),
+           "" if prs == NAN_PRESSURE else "%.2f" % (prs / 100.0),
+           "" if amb == NAN_TEMP else "%.2f" % (amb / 100.0)]
+    row = [str(ms), str(mq2), str(mq7)] + temps + bme
+    return row, pos
+
+
+def decode(stream, out, err):
+    buf = b""
+    last_seq = None
+    batches = lost = bad = 0
+    header_written = False
+    while True:
+        chunk = stream.read(512)
+        if not chunk:
+            break
+        buf += chunk
+        while True:
+            start = buf.find(SYNC)
+            if start < 0:
+                buf = buf[-1:]
+                break
+            buf = buf[start:]
+            if len(buf) < HEADER_SIZE:
+                break
+            version, count, seq, plen = struct.unpack_from("<BBHH", buf, 2)
+            total = HEADER_SIZE + plen + CRC_SIZE
+            if version != VERSION:
+                buf = buf[1:]
+                continue
+            if len(buf) < total:
+                break
+            (crc,) = struct.unpack_from("<H", buf, HEADER_SIZE + plen)
+            if crc != crc16(buf[:HEADER_SIZE + plen]):
+                bad += 1
+                buf = buf[1:]
+                continue
+            payload = buf[HEADER_SIZE:HEADER_SIZE + plen]
+            buf = buf[total:]
+
+            if last_seq is not None:
+                gap = (seq - last_seq - 1) & 0xFFFF
+                if gap:
+                    lost += gap
+                    err.write("stream: %d batch hilang sebelum seq %d\n" % (gap, seq))
+            last_seq = seq
+            batches += 1
+
+            pos = 0
+            for _ in range(count):
+                row, pos = decode_record(payload, pos)
+                if not header_written:
+                    ntemp = len(row) - 6
+                    out.write(",".join(["ms", "mq2", "mq7"] + ["temp%d" % (i + 1) for i in range(ntemp)]
+                                       + ["humidity", "pressure", "ambient"]) + "\n")
+                    header_written = True
+                out.write(",".join(row) + "\n")
+            out.flush()
+    err.write("stream: %d batch, %d hilang, %d CRC rusak\n" % (batches, lost, bad))
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    ap.add_argument("input", help="file capture atau port serial")
+    ap.add_argument("--baud", type=int, default=115200)
+    args = ap.parse_args()
+
+    if args.input.startswith(("/dev/", "COM")):
+        import serial
+        stream = serial.Serial(args.input, args.baud)
+    else:
+        stream = open(args.input, "rb")
+    decode(stream, sys.stdout, sys.stderr)
+
+
+if __name__ == "__main__":
+    main()